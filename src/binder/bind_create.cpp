@@ -129,7 +129,60 @@ auto Binder::BindIndex(duckdb_libpgquery::PGIndexStmt *stmt) -> std::unique_ptr<
     }
   }
 
-  return std::make_unique<IndexStatement>(stmt->idxname, std::move(table), std::move(cols));
+  // Covering columns are given as an index option, e.g. `WITH (include = 'v2, v3')`, as are the B-link mode of a
+  // B+ tree, `WITH (blink = true)`, and linear probing for a hash index, `WITH (linear_probe = true)`
+  std::vector<std::unique_ptr<BoundColumnRef>> include_cols;
+  bool blink = false;
+  bool linear_probe = false;
+  if (stmt->options != nullptr) {
+    for (auto cell = stmt->options->head; cell != nullptr; cell = cell->next) {
+      auto option = reinterpret_cast<duckdb_libpgquery::PGDefElem *>(cell->data.ptr_value);
+      if (strcmp(option->defname, "blink") == 0 || strcmp(option->defname, "linear_probe") == 0) {
+        if (option->arg != nullptr && option->arg->type != duckdb_libpgquery::T_PGString) {
+          throw bustub::Exception(fmt::format("{} option should be true or false", option->defname));
+        }
+        bool enabled =
+            option->arg == nullptr ||
+            StringUtil::Lower(reinterpret_cast<duckdb_libpgquery::PGValue *>(option->arg)->val.str) == "true";
+        if (strcmp(option->defname, "blink") == 0) {
+          blink = enabled;
+        } else {
+          linear_probe = enabled;
+        }
+        continue;
+      }
+      if (strcmp(option->defname, "include") != 0) {
+        throw NotImplementedException(fmt::format("unsupported index option {}", option->defname));
+      }
+      if (option->arg == nullptr || option->arg->type != duckdb_libpgquery::T_PGString) {
+        throw bustub::Exception("include option should list the columns, e.g. include = 'v2, v3'");
+      }
+      auto names = reinterpret_cast<duckdb_libpgquery::PGValue *>(option->arg)->val.str;
+      for (const auto &name : StringUtil::Split(names, ',')) {
+        auto column_ref = ResolveColumn(*table, std::vector{StringUtil::Strip(name, ' ')});
+        include_cols.emplace_back(std::make_unique<BoundColumnRef>(dynamic_cast<const BoundColumnRef &>(*column_ref)));
+      }
+    }
+  }
+
+  // `USING HASH` builds a hash index, a B+ tree is the default
+  auto index_type = IndexType::BPlusTreeIndex;
+  auto access_method = StringUtil::Lower(stmt->accessMethod);
+  if (access_method == "hash") {
+    index_type = linear_probe ? IndexType::LinearProbeHashIndex : IndexType::HashTableIndex;
+    if (!include_cols.empty() || blink) {
+      throw NotImplementedException("a hash index takes no index options but linear_probe");
+    }
+  } else if (access_method != DEFAULT_INDEX_TYPE && access_method != "btree") {
+    throw NotImplementedException(fmt::format("unsupported index type {}", access_method));
+  } else if (linear_probe) {
+    throw NotImplementedException("linear_probe is an option of hash indexes");
+  } else if (blink) {
+    index_type = IndexType::BLinkTreeIndex;
+  }
+
+  return std::make_unique<IndexStatement>(stmt->idxname, std::move(table), std::move(cols), std::move(include_cols),
+                                          index_type);
 }
 
 }  // namespace bustub
@@ -232,15 +232,47 @@ auto BustubInstance::ExecuteSqlTxn(const std::string &sql, ResultWriter &writer,
             throw NotImplementedException("only support creating index on integer column");
           }
         }
-        if (col_ids.size() != 1) {
-          throw NotImplementedException("only support creating index with exactly one column");
+        // Included columns are stored after the key columns in every index entry
+        std::vector<uint32_t> include_ids;
+        for (const auto &col : index_stmt.include_cols_) {
+          auto idx = index_stmt.table_->schema_.GetColIdx(col->col_name_.back());
+          include_ids.push_back(idx);
+          if (!index_stmt.table_->schema_.GetColumn(idx).IsInlined()) {
+            throw NotImplementedException("only support including inlined columns in an index");
+          }
         }
         auto key_schema = Schema::CopySchema(&index_stmt.table_->schema_, col_ids);
+        std::vector<uint32_t> entry_ids = col_ids;
+        entry_ids.insert(entry_ids.end(), include_ids.begin(), include_ids.end());
+        auto entry_schema = Schema::CopySchema(&index_stmt.table_->schema_, entry_ids);
 
+        // Use the narrowest generic key that holds all the key and included columns
         std::unique_lock<std::shared_mutex> l(catalog_lock_);
-        auto info = catalog_->CreateIndex<IntegerKeyType, IntegerValueType, IntegerComparatorType>(
-            txn, index_stmt.index_name_, index_stmt.table_->table_, index_stmt.table_->schema_, key_schema, col_ids,
-            INTEGER_SIZE, IntegerHashFunctionType{});
+        IndexInfo *info = nullptr;
+        auto key_size = entry_schema.GetLength();
+        if (key_size <= INTEGER_SIZE) {
+          info = catalog_->CreateIndex<IntegerKeyType, IntegerValueType, IntegerComparatorType>(
+              txn, index_stmt.index_name_, index_stmt.table_->table_, index_stmt.table_->schema_, key_schema, col_ids,
+              key_size, IntegerHashFunctionType{}, include_ids, index_stmt.index_type_);
+        } else if (key_size <= 8) {
+          info = catalog_->CreateIndex<GenericKey<8>, RID, GenericComparator<8>>(
+              txn, index_stmt.index_name_, index_stmt.table_->table_, index_stmt.table_->schema_, key_schema, col_ids,
+              key_size, HashFunction<GenericKey<8>>{}, include_ids, index_stmt.index_type_);
+        } else if (key_size <= 16) {
+          info = catalog_->CreateIndex<GenericKey<16>, RID, GenericComparator<16>>(
+              txn, index_stmt.index_name_, index_stmt.table_->table_, index_stmt.table_->schema_, key_schema, col_ids,
+              key_size, HashFunction<GenericKey<16>>{}, include_ids, index_stmt.index_type_);
+        } else if (key_size <= 32) {
+          info = catalog_->CreateIndex<GenericKey<32>, RID, GenericComparator<32>>(
+              txn, index_stmt.index_name_, index_stmt.table_->table_, index_stmt.table_->schema_, key_schema, col_ids,
+              key_size, HashFunction<GenericKey<32>>{}, include_ids, index_stmt.index_type_);
+        } else if (key_size <= 64) {
+          info = catalog_->CreateIndex<GenericKey<64>, RID, GenericComparator<64>>(
+              txn, index_stmt.index_name_, index_stmt.table_->table_, index_stmt.table_->schema_, key_schema, col_ids,
+              key_size, HashFunction<GenericKey<64>>{}, include_ids, index_stmt.index_type_);
+        } else {
+          throw NotImplementedException("index entry is too wide, at most 64 bytes are supported");
+        }
         l.unlock();
 
         if (info == nullptr) {
@@ -322,6 +354,9 @@ auto BustubInstance::ExecuteSqlTxn(const std::string &sql, ResultWriter &writer,
 
     // Execute the query.
     auto exec_ctx = MakeExecutorContext(txn);
+    if (auto budget = GetExecutionMemoryBudget(); budget > 0) {
+      exec_ctx->SetMemoryBudget(budget);
+    }
     std::vector<Tuple> result_set{};
     is_successful &= execution_engine_->Execute(optimized_plan, &result_set, txn, exec_ctx.get());
 
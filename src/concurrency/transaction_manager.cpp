@@ -94,15 +94,17 @@ void TransactionManager::Abort(Transaction *txn) {
     auto new_key = item.tuple_.KeyFromTuple(table_info->schema_, *(index_info->index_->GetKeySchema()),
                                             index_info->index_->GetKeyAttrs());
     if (item.wtype_ == WType::DELETE) {
-      index_info->index_->InsertEntry(new_key, item.rid_, txn);
+      auto new_entry = item.tuple_.KeyFromTuple(table_info->schema_, *(index_info->index_->GetEntrySchema()),
+                                                index_info->index_->GetEntryAttrs());
+      index_info->index_->InsertEntry(new_entry, item.rid_, txn);
     } else if (item.wtype_ == WType::INSERT) {
       index_info->index_->DeleteEntry(new_key, item.rid_, txn);
     } else if (item.wtype_ == WType::UPDATE) {
       // Delete the new key and insert the old key
       index_info->index_->DeleteEntry(new_key, item.rid_, txn);
-      auto old_key = item.old_tuple_.KeyFromTuple(table_info->schema_, *(index_info->index_->GetKeySchema()),
-                                                  index_info->index_->GetKeyAttrs());
-      index_info->index_->InsertEntry(old_key, item.rid_, txn);
+      auto old_entry = item.old_tuple_.KeyFromTuple(table_info->schema_, *(index_info->index_->GetEntrySchema()),
+                                                    index_info->index_->GetEntryAttrs());
+      index_info->index_->InsertEntry(old_entry, item.rid_, txn);
     }
     index_write_set->pop_back();
   }
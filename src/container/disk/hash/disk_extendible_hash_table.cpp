@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <utility>
@@ -26,7 +27,16 @@ template <typename KeyType, typename ValueType, typename KeyComparator>
 HASH_TABLE_TYPE::DiskExtendibleHashTable(const std::string &name, BufferPoolManager *buffer_pool_manager,
                                          const KeyComparator &comparator, HashFunction<KeyType> hash_fn)
     : buffer_pool_manager_(buffer_pool_manager), comparator_(comparator), hash_fn_(std::move(hash_fn)) {
-  //  implement me!
+  // a directory of global depth 0 pointing at a single empty bucket
+  auto *dir_page =
+      reinterpret_cast<HashTableDirectoryPage *>(buffer_pool_manager_->NewPage(&directory_page_id_)->GetData());
+  dir_page->SetPageId(directory_page_id_);
+  page_id_t bucket_page_id;
+  NewBucketPage(&bucket_page_id);
+  dir_page->SetBucketPageId(0, bucket_page_id);
+  dir_page->SetLocalDepth(0, 0);
+  buffer_pool_manager_->UnpinPage(bucket_page_id, true);
+  buffer_pool_manager_->UnpinPage(directory_page_id_, true);
 }
 
 /*****************************************************************************
@@ -46,22 +56,92 @@ auto HASH_TABLE_TYPE::Hash(KeyType key) -> uint32_t {
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 inline auto HASH_TABLE_TYPE::KeyToDirectoryIndex(KeyType key, HashTableDirectoryPage *dir_page) -> uint32_t {
-  return 0;
+  return Hash(key) & dir_page->GetGlobalDepthMask();
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 inline auto HASH_TABLE_TYPE::KeyToPageId(KeyType key, HashTableDirectoryPage *dir_page) -> page_id_t {
-  return 0;
+  return dir_page->GetBucketPageId(KeyToDirectoryIndex(key, dir_page));
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::FetchDirectoryPage() -> HashTableDirectoryPage * {
-  return nullptr;
+  return reinterpret_cast<HashTableDirectoryPage *>(buffer_pool_manager_->FetchPage(directory_page_id_)->GetData());
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::FetchBucketPage(page_id_t bucket_page_id) -> HASH_TABLE_BUCKET_TYPE * {
-  return nullptr;
+  return reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(buffer_pool_manager_->FetchPage(bucket_page_id)->GetData());
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_TYPE::NewBucketPage(page_id_t *bucket_page_id) -> HASH_TABLE_BUCKET_TYPE * {
+  auto *bucket_page =
+      reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(buffer_pool_manager_->NewPage(bucket_page_id)->GetData());
+  bucket_page->Init();
+  return bucket_page;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_TYPE::InsertIntoChain(HASH_TABLE_BUCKET_TYPE *bucket_page, const KeyType &key, const ValueType &value,
+                                      bool append) -> std::optional<bool> {
+  // a pair may only appear once in the whole chain
+  std::vector<ValueType> values;
+  bucket_page->GetValue(key, comparator_, &values);
+  for (page_id_t page_id = bucket_page->GetNextPageId(); page_id != INVALID_PAGE_ID;) {
+    auto *overflow_page = FetchBucketPage(page_id);
+    overflow_page->GetValue(key, comparator_, &values);
+    page_id_t next_page_id = overflow_page->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    page_id = next_page_id;
+  }
+  if (std::find(values.begin(), values.end(), value) != values.end()) {
+    return false;
+  }
+
+  if (!bucket_page->IsFull()) {
+    return bucket_page->Insert(key, value, comparator_);
+  }
+  // the first overflow page with a free slot takes the pair, or a new page at the end of the chain
+  HASH_TABLE_BUCKET_TYPE *last_page = bucket_page;
+  page_id_t last_page_id = INVALID_PAGE_ID;
+  while (last_page->GetNextPageId() != INVALID_PAGE_ID) {
+    page_id_t page_id = last_page->GetNextPageId();
+    auto *overflow_page = FetchBucketPage(page_id);
+    if (last_page_id != INVALID_PAGE_ID) {
+      buffer_pool_manager_->UnpinPage(last_page_id, false);
+    }
+    last_page = overflow_page;
+    last_page_id = page_id;
+    if (!overflow_page->IsFull()) {
+      overflow_page->Insert(key, value, comparator_);
+      buffer_pool_manager_->UnpinPage(page_id, true);
+      return true;
+    }
+  }
+  if (!append) {
+    if (last_page_id != INVALID_PAGE_ID) {
+      buffer_pool_manager_->UnpinPage(last_page_id, false);
+    }
+    return std::nullopt;
+  }
+  page_id_t new_page_id;
+  auto *new_page = NewBucketPage(&new_page_id);
+  new_page->Insert(key, value, comparator_);
+  last_page->SetNextPageId(new_page_id);
+  buffer_pool_manager_->UnpinPage(new_page_id, true);
+  if (last_page_id != INVALID_PAGE_ID) {
+    buffer_pool_manager_->UnpinPage(last_page_id, true);
+  }
+  return true;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_TYPE::IsBucketEmpty(page_id_t bucket_page_id) -> bool {
+  auto *bucket_page = FetchBucketPage(bucket_page_id);
+  bool empty = bucket_page->IsEmpty() && bucket_page->GetNextPageId() == INVALID_PAGE_ID;
+  buffer_pool_manager_->UnpinPage(bucket_page_id, false);
+  return empty;
 }
 
 /*****************************************************************************
@@ -69,7 +149,26 @@ auto HASH_TABLE_TYPE::FetchBucketPage(page_id_t bucket_page_id) -> HASH_TABLE_BU
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::GetValue(Transaction *transaction, const KeyType &key, std::vector<ValueType> *result) -> bool {
-  return false;
+  // the directory cannot change under the table read latch, the primary page latch of a bucket covers its chain
+  table_latch_.RLock();
+  HashTableDirectoryPage *dir_page = FetchDirectoryPage();
+  page_id_t bucket_page_id = KeyToPageId(key, dir_page);
+  Page *page = buffer_pool_manager_->FetchPage(bucket_page_id);
+  page->RLatch();
+  auto *bucket_page = reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(page->GetData());
+  bool found = bucket_page->GetValue(key, comparator_, result);
+  for (page_id_t page_id = bucket_page->GetNextPageId(); page_id != INVALID_PAGE_ID;) {
+    auto *overflow_page = FetchBucketPage(page_id);
+    found = overflow_page->GetValue(key, comparator_, result) || found;
+    page_id_t next_page_id = overflow_page->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    page_id = next_page_id;
+  }
+  page->RUnlatch();
+  buffer_pool_manager_->UnpinPage(bucket_page_id, false);
+  buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+  table_latch_.RUnlock();
+  return found;
 }
 
 /*****************************************************************************
@@ -77,12 +176,102 @@ auto HASH_TABLE_TYPE::GetValue(Transaction *transaction, const KeyType &key, std
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::Insert(Transaction *transaction, const KeyType &key, const ValueType &value) -> bool {
-  return false;
+  table_latch_.RLock();
+  HashTableDirectoryPage *dir_page = FetchDirectoryPage();
+  page_id_t bucket_page_id = KeyToPageId(key, dir_page);
+  Page *page = buffer_pool_manager_->FetchPage(bucket_page_id);
+  page->WLatch();
+  auto *bucket_page = reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(page->GetData());
+  auto inserted = InsertIntoChain(bucket_page, key, value, false);
+  page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(bucket_page_id, inserted.value_or(false));
+  buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+  table_latch_.RUnlock();
+  if (inserted.has_value()) {
+    return *inserted;
+  }
+  // the bucket has to be split, which changes the directory
+  return SplitInsert(transaction, key, value);
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::SplitInsert(Transaction *transaction, const KeyType &key, const ValueType &value) -> bool {
-  return false;
+  table_latch_.WLock();
+  HashTableDirectoryPage *dir_page = FetchDirectoryPage();
+  bool dir_dirty = false;
+  bool inserted = false;
+  while (true) {
+    uint32_t bucket_idx = KeyToDirectoryIndex(key, dir_page);
+    page_id_t bucket_page_id = dir_page->GetBucketPageId(bucket_idx);
+    HASH_TABLE_BUCKET_TYPE *bucket_page = FetchBucketPage(bucket_page_id);
+    // another writer may have split the bucket before the table latch was taken
+    auto result = InsertIntoChain(bucket_page, key, value, false);
+    if (result.has_value()) {
+      inserted = *result;
+      buffer_pool_manager_->UnpinPage(bucket_page_id, inserted);
+      break;
+    }
+
+    // collect the pairs of the whole chain and free its overflow pages
+    std::vector<MappingType> entries;
+    bool splittable = false;
+    uint32_t key_hash = Hash(key);
+    for (page_id_t page_id = bucket_page_id; page_id != INVALID_PAGE_ID;) {
+      auto *chain_page = page_id == bucket_page_id ? bucket_page : FetchBucketPage(page_id);
+      for (uint32_t i = 0; i < BUCKET_ARRAY_SIZE && chain_page->IsOccupied(i); i++) {
+        if (chain_page->IsReadable(i)) {
+          entries.emplace_back(chain_page->KeyAt(i), chain_page->ValueAt(i));
+          splittable = splittable || Hash(chain_page->KeyAt(i)) != key_hash;
+        }
+      }
+      page_id_t next_page_id = chain_page->GetNextPageId();
+      if (page_id != bucket_page_id) {
+        buffer_pool_manager_->UnpinPage(page_id, false);
+      }
+      page_id = next_page_id;
+    }
+
+    // pairs that all hash alike stay together whatever the depth, as do pairs of a directory that cannot grow:
+    // chain another page to the bucket instead
+    uint32_t local_depth = dir_page->GetLocalDepth(bucket_idx);
+    if (!splittable || (local_depth == dir_page->GetGlobalDepth() && dir_page->Size() * 2 > DIRECTORY_ARRAY_SIZE)) {
+      inserted = *InsertIntoChain(bucket_page, key, value, true);
+      buffer_pool_manager_->UnpinPage(bucket_page_id, true);
+      break;
+    }
+    if (local_depth == dir_page->GetGlobalDepth()) {
+      dir_page->IncrGlobalDepth();
+    }
+
+    // only the directory slots aliasing the bucket change, the image takes those with the new depth bit set
+    page_id_t image_page_id;
+    auto *image_page = NewBucketPage(&image_page_id);
+    uint32_t high_bit = 1U << local_depth;
+    for (uint32_t i = bucket_idx & (high_bit - 1); i < dir_page->Size(); i += high_bit) {
+      dir_page->IncrLocalDepth(i);
+      if ((i & high_bit) != 0) {
+        dir_page->SetBucketPageId(i, image_page_id);
+      }
+    }
+    dir_dirty = true;
+
+    // rebuild both buckets from the collected pairs
+    for (page_id_t page_id = bucket_page->GetNextPageId(); page_id != INVALID_PAGE_ID;) {
+      page_id_t next_page_id = FetchBucketPage(page_id)->GetNextPageId();
+      buffer_pool_manager_->UnpinPage(page_id, false);
+      buffer_pool_manager_->DeletePage(page_id);
+      page_id = next_page_id;
+    }
+    bucket_page->Init();
+    for (const auto &[entry_key, entry_value] : entries) {
+      InsertIntoChain((Hash(entry_key) & high_bit) != 0 ? image_page : bucket_page, entry_key, entry_value, true);
+    }
+    buffer_pool_manager_->UnpinPage(image_page_id, true);
+    buffer_pool_manager_->UnpinPage(bucket_page_id, true);
+  }
+  buffer_pool_manager_->UnpinPage(directory_page_id_, dir_dirty);
+  table_latch_.WUnlock();
+  return inserted;
 }
 
 /*****************************************************************************
@@ -90,14 +279,99 @@ auto HASH_TABLE_TYPE::SplitInsert(Transaction *transaction, const KeyType &key,
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::Remove(Transaction *transaction, const KeyType &key, const ValueType &value) -> bool {
-  return false;
+  table_latch_.RLock();
+  HashTableDirectoryPage *dir_page = FetchDirectoryPage();
+  page_id_t bucket_page_id = KeyToPageId(key, dir_page);
+  Page *page = buffer_pool_manager_->FetchPage(bucket_page_id);
+  page->WLatch();
+  auto *bucket_page = reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(page->GetData());
+  bool removed = bucket_page->Remove(key, value, comparator_);
+  bool bucket_dirty = removed;
+  // look through the overflow pages, an overflow page left empty is unlinked from the chain
+  HASH_TABLE_BUCKET_TYPE *prev_page = bucket_page;
+  page_id_t prev_page_id = INVALID_PAGE_ID;
+  page_id_t page_id = bucket_page->GetNextPageId();
+  while (!removed && page_id != INVALID_PAGE_ID) {
+    auto *overflow_page = FetchBucketPage(page_id);
+    page_id_t next_page_id = overflow_page->GetNextPageId();
+    removed = overflow_page->Remove(key, value, comparator_);
+    bool unlink = removed && overflow_page->IsEmpty();
+    if (unlink) {
+      prev_page->SetNextPageId(next_page_id);
+      bucket_dirty = bucket_dirty || prev_page_id == INVALID_PAGE_ID;
+    }
+    if (prev_page_id != INVALID_PAGE_ID) {
+      buffer_pool_manager_->UnpinPage(prev_page_id, unlink);
+    }
+    if (removed) {
+      buffer_pool_manager_->UnpinPage(page_id, !unlink);
+      if (unlink) {
+        buffer_pool_manager_->DeletePage(page_id);
+      }
+      break;
+    }
+    prev_page = overflow_page;
+    prev_page_id = page_id;
+    page_id = next_page_id;
+  }
+  if (!removed && prev_page_id != INVALID_PAGE_ID) {
+    buffer_pool_manager_->UnpinPage(prev_page_id, false);
+  }
+  bool empty = bucket_page->IsEmpty() && bucket_page->GetNextPageId() == INVALID_PAGE_ID;
+  page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(bucket_page_id, bucket_dirty);
+  buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+  table_latch_.RUnlock();
+  if (removed && empty) {
+    Merge(transaction, key, value);
+  }
+  return removed;
 }
 
 /*****************************************************************************
  * MERGE
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
-void HASH_TABLE_TYPE::Merge(Transaction *transaction, const KeyType &key, const ValueType &value) {}
+void HASH_TABLE_TYPE::Merge(Transaction *transaction, const KeyType &key, const ValueType &value) {
+  table_latch_.WLock();
+  HashTableDirectoryPage *dir_page = FetchDirectoryPage();
+  uint32_t bucket_idx = KeyToDirectoryIndex(key, dir_page);
+  bool dir_dirty = false;
+  // merge up the path of the key for as long as one of the two images is empty, so that buckets emptied
+  // while their image was split deeper are folded in once the image has shrunk back
+  while (true) {
+    uint32_t local_depth = dir_page->GetLocalDepth(bucket_idx);
+    if (local_depth == 0) {
+      break;
+    }
+    uint32_t image_idx = dir_page->GetSplitImageIndex(bucket_idx);
+    if (dir_page->GetLocalDepth(image_idx) != local_depth) {
+      break;
+    }
+    page_id_t bucket_page_id = dir_page->GetBucketPageId(bucket_idx);
+    page_id_t image_page_id = dir_page->GetBucketPageId(image_idx);
+    bool bucket_empty = IsBucketEmpty(bucket_page_id);
+    if (!bucket_empty && !IsBucketEmpty(image_page_id)) {
+      break;
+    }
+
+    // the slots aliasing the merged bucket are those of both images
+    page_id_t kept_page_id = bucket_empty ? image_page_id : bucket_page_id;
+    uint32_t low_bits = (1U << (local_depth - 1)) - 1;
+    for (uint32_t i = bucket_idx & low_bits; i < dir_page->Size(); i += low_bits + 1) {
+      dir_page->SetBucketPageId(i, kept_page_id);
+      dir_page->DecrLocalDepth(i);
+    }
+    buffer_pool_manager_->DeletePage(bucket_empty ? bucket_page_id : image_page_id);
+    dir_dirty = true;
+  }
+  while (dir_page->CanShrink()) {
+    dir_page->DecrGlobalDepth();
+    dir_dirty = true;
+  }
+  buffer_pool_manager_->UnpinPage(directory_page_id_, dir_dirty);
+  table_latch_.WUnlock();
+}
 
 /*****************************************************************************
  * GETGLOBALDEPTH - DO NOT TOUCH
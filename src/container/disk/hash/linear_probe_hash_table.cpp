@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <utility>
@@ -23,46 +24,280 @@
 namespace bustub {
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
-HASH_TABLE_TYPE::LinearProbeHashTable(const std::string &name, BufferPoolManager *buffer_pool_manager,
-                                      const KeyComparator &comparator, size_t num_buckets,
-                                      HashFunction<KeyType> hash_fn)
-    : buffer_pool_manager_(buffer_pool_manager), comparator_(comparator), hash_fn_(std::move(hash_fn)) {}
+LINEAR_PROBE_HASH_TABLE_TYPE::LinearProbeHashTable(const std::string &name, BufferPoolManager *buffer_pool_manager,
+                                                   const KeyComparator &comparator, size_t num_buckets,
+                                                   HashFunction<KeyType> hash_fn)
+    : buffer_pool_manager_(buffer_pool_manager), comparator_(comparator), hash_fn_(std::move(hash_fn)) {
+  CreateTable(num_buckets);
+}
+
+/*****************************************************************************
+ * HELPERS
+ *****************************************************************************/
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto LINEAR_PROBE_HASH_TABLE_TYPE::GetHeaderPage() -> HashTableHeaderPage * {
+  return reinterpret_cast<HashTableHeaderPage *>(buffer_pool_manager_->FetchPage(header_page_id_)->GetData());
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto LINEAR_PROBE_HASH_TABLE_TYPE::GetBlockPage(page_id_t block_page_id) -> HASH_TABLE_BLOCK_TYPE * {
+  return reinterpret_cast<HASH_TABLE_BLOCK_TYPE *>(buffer_pool_manager_->FetchPage(block_page_id)->GetData());
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+template <typename Visitor>
+void LINEAR_PROBE_HASH_TABLE_TYPE::Probe(uint64_t hash, Visitor &&visit) {
+  // the fingerprint takes the low 7 bits, the start group the bits above them
+  size_t num_groups = block_page_ids_.size() * GROUPS_PER_BLOCK;
+  size_t group = (hash >> 7) % num_groups;
+  for (size_t probed = 0; probed < num_groups; probed++, group = (group + 1) % num_groups) {
+    page_id_t block_page_id = block_page_ids_[group / GROUPS_PER_BLOCK];
+    auto *block_page = GetBlockPage(block_page_id);
+    bool dirty = false;
+    bool done = visit(block_page_id, block_page, group % GROUPS_PER_BLOCK, &dirty);
+    buffer_pool_manager_->UnpinPage(block_page_id, dirty);
+    if (done) {
+      return;
+    }
+  }
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void LINEAR_PROBE_HASH_TABLE_TYPE::CreateTable(size_t num_buckets) {
+  size_t num_blocks = std::max<size_t>(1, (num_buckets + BLOCK_ARRAY_SIZE - 1) / BLOCK_ARRAY_SIZE);
+  auto *header_page =
+      reinterpret_cast<HashTableHeaderPage *>(buffer_pool_manager_->NewPage(&header_page_id_)->GetData());
+  header_page->Init(header_page_id_);
+  header_page->SetSize(num_blocks * BLOCK_ARRAY_SIZE);
+
+  // the block page ids continue in a new header page once a header page is full
+  block_page_ids_.clear();
+  block_page_ids_.reserve(num_blocks);
+  HashTableHeaderPage *last_page = header_page;
+  page_id_t last_page_id = header_page_id_;
+  for (size_t i = 0; i < num_blocks; i++) {
+    if (last_page->IsFull()) {
+      page_id_t next_page_id;
+      auto *next_page =
+          reinterpret_cast<HashTableHeaderPage *>(buffer_pool_manager_->NewPage(&next_page_id)->GetData());
+      next_page->Init(next_page_id);
+      last_page->SetNextPageId(next_page_id);
+      buffer_pool_manager_->UnpinPage(last_page_id, true);
+      last_page = next_page;
+      last_page_id = next_page_id;
+    }
+    page_id_t block_page_id;
+    auto *block_page =
+        reinterpret_cast<HASH_TABLE_BLOCK_TYPE *>(buffer_pool_manager_->NewPage(&block_page_id)->GetData());
+    block_page->Init();
+    buffer_pool_manager_->UnpinPage(block_page_id, true);
+    last_page->AddBlockPageId(block_page_id);
+    block_page_ids_.push_back(block_page_id);
+  }
+  buffer_pool_manager_->UnpinPage(last_page_id, true);
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void LINEAR_PROBE_HASH_TABLE_TYPE::DeleteTablePages(page_id_t header_page_id,
+                                                    const std::vector<page_id_t> &block_page_ids) {
+  for (page_id_t block_page_id : block_page_ids) {
+    buffer_pool_manager_->DeletePage(block_page_id);
+  }
+  for (page_id_t page_id = header_page_id; page_id != INVALID_PAGE_ID;) {
+    auto *header_page = reinterpret_cast<HashTableHeaderPage *>(buffer_pool_manager_->FetchPage(page_id)->GetData());
+    page_id_t next_page_id = header_page->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    buffer_pool_manager_->DeletePage(page_id);
+    page_id = next_page_id;
+  }
+}
 
 /*****************************************************************************
  * SEARCH
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
-auto HASH_TABLE_TYPE::GetValue(Transaction *transaction, const KeyType &key, std::vector<ValueType> *result) -> bool {
-  return false;
+auto LINEAR_PROBE_HASH_TABLE_TYPE::GetValue(Transaction *transaction, const KeyType &key,
+                                            std::vector<ValueType> *result) -> bool {
+  table_latch_.RLock();
+  bool found = GetValueLatchFree(transaction, key, result);
+  table_latch_.RUnlock();
+  return found;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto LINEAR_PROBE_HASH_TABLE_TYPE::GetValueLatchFree(Transaction *transaction, const KeyType &key,
+                                                     std::vector<ValueType> *result) -> bool {
+  uint64_t hash = hash_fn_.GetHash(key);
+  auto fingerprint = static_cast<uint8_t>(hash & 0x7F);
+  bool found = false;
+  Probe(hash, [&](page_id_t block_page_id, HASH_TABLE_BLOCK_TYPE *block_page, size_t group, bool *dirty) {
+    for (uint32_t match = block_page->MatchFingerprint(group, fingerprint); match != 0; match &= match - 1) {
+      auto slot = static_cast<slot_offset_t>(group * BLOCK_GROUP_SIZE + __builtin_ctz(match));
+      if (comparator_(block_page->KeyAt(slot), key) == 0) {
+        result->push_back(block_page->ValueAt(slot));
+        found = true;
+      }
+    }
+    // no pair of the key was ever pushed past a group with an empty slot
+    return block_page->MatchEmpty(group) != 0;
+  });
+  return found;
 }
+
 /*****************************************************************************
  * INSERTION
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
-auto HASH_TABLE_TYPE::Insert(Transaction *transaction, const KeyType &key, const ValueType &value) -> bool {
-  return false;
+auto LINEAR_PROBE_HASH_TABLE_TYPE::Insert(Transaction *transaction, const KeyType &key, const ValueType &value)
+    -> bool {
+  table_latch_.WLock();
+  auto *header_page = GetHeaderPage();
+  size_t size = header_page->GetSize();
+  size_t num_entries = header_page->GetNumEntries();
+  size_t num_tombstones = header_page->GetNumTombstones();
+  buffer_pool_manager_->UnpinPage(header_page_id_, false);
+  // keep at least one eighth of the slots empty so that probes stay short; when tombstones take most of the used
+  // slots, rebuilding at the same size is enough
+  if ((num_entries + num_tombstones + 1) * 8 > size * 7) {
+    Rebuild((num_entries + 1) * 16 > size * 7 ? size * 2 : size);
+  }
+
+  bool reused_tombstone = false;
+  bool inserted = InsertLatchFree(key, value, &reused_tombstone);
+  if (inserted) {
+    header_page = GetHeaderPage();
+    header_page->SetNumEntries(header_page->GetNumEntries() + 1);
+    if (reused_tombstone) {
+      header_page->SetNumTombstones(header_page->GetNumTombstones() - 1);
+    }
+    buffer_pool_manager_->UnpinPage(header_page_id_, true);
+  }
+  table_latch_.WUnlock();
+  return inserted;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto LINEAR_PROBE_HASH_TABLE_TYPE::InsertLatchFree(const KeyType &key, const ValueType &value, bool *reused_tombstone)
+    -> bool {
+  uint64_t hash = hash_fn_.GetHash(key);
+  auto fingerprint = static_cast<uint8_t>(hash & 0x7F);
+  // a pair may only appear once, so the probe goes on to the end of the sequence after finding a free slot
+  bool duplicate = false;
+  page_id_t free_page_id = INVALID_PAGE_ID;
+  slot_offset_t free_slot = 0;
+  Probe(hash, [&](page_id_t block_page_id, HASH_TABLE_BLOCK_TYPE *block_page, size_t group, bool *dirty) {
+    for (uint32_t match = block_page->MatchFingerprint(group, fingerprint); match != 0; match &= match - 1) {
+      auto slot = static_cast<slot_offset_t>(group * BLOCK_GROUP_SIZE + __builtin_ctz(match));
+      if (comparator_(block_page->KeyAt(slot), key) == 0 && block_page->ValueAt(slot) == value) {
+        duplicate = true;
+        return true;
+      }
+    }
+    uint32_t free = block_page->MatchFree(group);
+    if (free_page_id == INVALID_PAGE_ID && free != 0) {
+      free_page_id = block_page_id;
+      free_slot = static_cast<slot_offset_t>(group * BLOCK_GROUP_SIZE + __builtin_ctz(free));
+    }
+    return block_page->MatchEmpty(group) != 0;
+  });
+  if (duplicate) {
+    return false;
+  }
+  BUSTUB_ASSERT(free_page_id != INVALID_PAGE_ID, "the load factor keeps a free slot");
+  auto *block_page = GetBlockPage(free_page_id);
+  *reused_tombstone = block_page->IsOccupied(free_slot);
+  block_page->Insert(free_slot, key, value, fingerprint);
+  buffer_pool_manager_->UnpinPage(free_page_id, true);
+  return true;
 }
 
 /*****************************************************************************
  * REMOVE
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
-auto HASH_TABLE_TYPE::Remove(Transaction *transaction, const KeyType &key, const ValueType &value) -> bool {
-  return false;
+auto LINEAR_PROBE_HASH_TABLE_TYPE::Remove(Transaction *transaction, const KeyType &key, const ValueType &value)
+    -> bool {
+  table_latch_.WLock();
+  uint64_t hash = hash_fn_.GetHash(key);
+  auto fingerprint = static_cast<uint8_t>(hash & 0x7F);
+  bool removed = false;
+  bool tombstone = false;
+  Probe(hash, [&](page_id_t block_page_id, HASH_TABLE_BLOCK_TYPE *block_page, size_t group, bool *dirty) {
+    for (uint32_t match = block_page->MatchFingerprint(group, fingerprint); match != 0; match &= match - 1) {
+      auto slot = static_cast<slot_offset_t>(group * BLOCK_GROUP_SIZE + __builtin_ctz(match));
+      if (comparator_(block_page->KeyAt(slot), key) == 0 && block_page->ValueAt(slot) == value) {
+        // probes only pass a group without empty slots, the slot of a group that has one can be empty again
+        tombstone = block_page->MatchEmpty(group) == 0;
+        block_page->Remove(slot, tombstone);
+        *dirty = true;
+        removed = true;
+        return true;
+      }
+    }
+    return block_page->MatchEmpty(group) != 0;
+  });
+  if (removed) {
+    auto *header_page = GetHeaderPage();
+    header_page->SetNumEntries(header_page->GetNumEntries() - 1);
+    if (tombstone) {
+      header_page->SetNumTombstones(header_page->GetNumTombstones() + 1);
+    }
+    buffer_pool_manager_->UnpinPage(header_page_id_, true);
+  }
+  table_latch_.WUnlock();
+  return removed;
 }
 
 /*****************************************************************************
  * RESIZE
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
-void HASH_TABLE_TYPE::Resize(size_t initial_size) {}
+void LINEAR_PROBE_HASH_TABLE_TYPE::Resize(size_t initial_size) {
+  table_latch_.WLock();
+  Rebuild(initial_size * 2);
+  table_latch_.WUnlock();
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void LINEAR_PROBE_HASH_TABLE_TYPE::Rebuild(size_t num_buckets) {
+  // the new table has to hold every pair below the load factor
+  auto *old_header_page = GetHeaderPage();
+  num_buckets = std::max(num_buckets, (old_header_page->GetNumEntries() + 1) * 8 / 7 + 1);
+  buffer_pool_manager_->UnpinPage(header_page_id_, false);
+
+  page_id_t old_header_page_id = header_page_id_;
+  std::vector<page_id_t> old_block_page_ids = std::move(block_page_ids_);
+  CreateTable(num_buckets);
+
+  size_t num_entries = 0;
+  for (page_id_t block_page_id : old_block_page_ids) {
+    auto *block_page = GetBlockPage(block_page_id);
+    for (slot_offset_t slot = 0; slot < BLOCK_ARRAY_SIZE; slot++) {
+      bool reused_tombstone;
+      if (block_page->IsReadable(slot) &&
+          InsertLatchFree(block_page->KeyAt(slot), block_page->ValueAt(slot), &reused_tombstone)) {
+        num_entries++;
+      }
+    }
+    buffer_pool_manager_->UnpinPage(block_page_id, false);
+  }
+  auto *header_page = GetHeaderPage();
+  header_page->SetNumEntries(num_entries);
+  buffer_pool_manager_->UnpinPage(header_page_id_, true);
+  DeleteTablePages(old_header_page_id, old_block_page_ids);
+}
 
 /*****************************************************************************
  * GETSIZE
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
-auto HASH_TABLE_TYPE::GetSize() -> size_t {
-  return 0;
+auto LINEAR_PROBE_HASH_TABLE_TYPE::GetSize() -> size_t {
+  table_latch_.RLock();
+  auto *header_page = GetHeaderPage();
+  size_t size = header_page->GetSize();
+  buffer_pool_manager_->UnpinPage(header_page_id_, false);
+  table_latch_.RUnlock();
+  return size;
 }
 
 template class LinearProbeHashTable<int, int, IntComparator>;
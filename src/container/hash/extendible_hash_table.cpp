@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
 #include <functional>
@@ -24,18 +25,19 @@ namespace bustub {
 template <typename K, typename V>
 ExtendibleHashTable<K, V>::ExtendibleHashTable(size_t bucket_size)
     : global_depth_(0), bucket_size_(bucket_size), num_buckets_(1) {
-  dir_.emplace_back(std::make_shared<Bucket>(bucket_size));
+  buckets_.emplace_back(std::make_unique<Bucket>(bucket_size));
+  dir_.emplace_back(buckets_.back().get());
 }
 
 template <typename K, typename V>
-auto ExtendibleHashTable<K, V>::IndexOf(const K &key) -> size_t {
-  int mask = (1 << global_depth_) - 1;
+auto ExtendibleHashTable<K, V>::IndexOf(const K &key) const -> size_t {
+  size_t mask = (static_cast<size_t>(1) << global_depth_) - 1;
   return std::hash<K>()(key) & mask;
 }
 
 template <typename K, typename V>
 auto ExtendibleHashTable<K, V>::GetGlobalDepth() const -> int {
-  std::scoped_lock<std::mutex> lock(latch_);
+  std::shared_lock lock(latch_);
   return GetGlobalDepthInternal();
 }
 
@@ -46,7 +48,7 @@ auto ExtendibleHashTable<K, V>::GetGlobalDepthInternal() const -> int {
 
 template <typename K, typename V>
 auto ExtendibleHashTable<K, V>::GetLocalDepth(int dir_index) const -> int {
-  std::scoped_lock<std::mutex> lock(latch_);
+  std::shared_lock lock(latch_);
   return GetLocalDepthInternal(dir_index);
 }
 
@@ -57,7 +59,7 @@ auto ExtendibleHashTable<K, V>::GetLocalDepthInternal(int dir_index) const -> in
 
 template <typename K, typename V>
 auto ExtendibleHashTable<K, V>::GetNumBuckets() const -> int {
-  std::scoped_lock<std::mutex> lock(latch_);
+  std::shared_lock lock(latch_);
   return GetNumBucketsInternal();
 }
 
@@ -68,126 +70,139 @@ auto ExtendibleHashTable<K, V>::GetNumBucketsInternal() const -> int {
 
 template <typename K, typename V>
 auto ExtendibleHashTable<K, V>::Find(const K &key, V &value) -> bool {
-  std::scoped_lock<std::mutex> lock(latch_);
-  // 获取与key对应的bucket
-  size_t index = ExtendibleHashTable<K, V>::IndexOf(key);
-  std::shared_ptr<Bucket> cur_bucket = dir_[index];
-  // 对应bucket查找
+  // 目录读锁期间bucket不会分裂，只需bucket读锁
+  std::shared_lock lock(latch_);
+  const Bucket *cur_bucket = dir_[IndexOf(key)];
+  std::shared_lock bucket_lock(cur_bucket->GetLatch());
   return cur_bucket->Find(key, value);
 }
 
 template <typename K, typename V>
 auto ExtendibleHashTable<K, V>::Remove(const K &key) -> bool {
-  // Todo : 加锁
-  std::scoped_lock<std::mutex> lock(latch_);
-  // 获取与key对应的bucket
-  size_t index = ExtendibleHashTable<K, V>::IndexOf(key);
-  std::shared_ptr<Bucket> cur_bucket = dir_[index];
+  std::shared_lock lock(latch_);
+  Bucket *cur_bucket = dir_[IndexOf(key)];
+  std::scoped_lock bucket_lock(cur_bucket->GetLatch());
   return cur_bucket->Remove(key);
 }
 
-// * @brief Insert the given key-value pair into the hash table.
-//  * If a key already exists, the value should be updated.
-//  * If the bucket is full and can't be inserted, do the following steps before retrying:
-//  *    1. If the local depth of the bucket is equal to the global depth,
-//  *        increment the global depth and double the size of the directory.
-//  *    2. Increment the local depth of the bucket.
-//  *    3. Split the bucket and redistribute directory pointers & the kv pairs in the bucket.
-
 template <typename K, typename V>
 void ExtendibleHashTable<K, V>::Insert(const K &key, const V &value) {
-  std::scoped_lock<std::mutex> lock(latch_);
-  while (dir_[IndexOf(key)]->IsFull()) {
-    auto index = IndexOf(key);
-    auto target_bucket = dir_[index];
-    if (target_bucket->GetDepth() == GetGlobalDepthInternal()) {
-      global_depth_++;
-      int capacity = dir_.size();
-      dir_.resize(capacity << 1);
-      for (int i = 0; i < capacity; i++) {
-        dir_[i + capacity] = dir_[i];
-      }
-    }
-    int mask = 1 << target_bucket->GetDepth();
-    auto bucket_0 = std::make_shared<Bucket>(bucket_size_, target_bucket->GetDepth() + 1);
-    auto bucket_1 = std::make_shared<Bucket>(bucket_size_, target_bucket->GetDepth() + 1);
-    for (const auto &item : target_bucket->GetItems()) {
-      size_t hash_key = std::hash<K>()(item.first);
-      if ((hash_key & mask) != 0U) {
-        bucket_1->Insert(item.first, item.second);
-      } else {
-        bucket_0->Insert(item.first, item.second);
-      }
-    }
-    num_buckets_++;
-    for (size_t i = 0; i < dir_.size(); i++) {
-      if (dir_[i] == target_bucket) {
-        if ((i & mask) != 0U) {
-          dir_[i] = bucket_1;
-        } else {
-          dir_[i] = bucket_0;
-        }
-      }
+  {
+    // 乐观插入：bucket未满或key已存在时不需要分裂
+    std::shared_lock lock(latch_);
+    Bucket *cur_bucket = dir_[IndexOf(key)];
+    std::scoped_lock bucket_lock(cur_bucket->GetLatch());
+    if (cur_bucket->Insert(key, value)) {
+      return;
     }
   }
-  auto index = IndexOf(key);
-  auto target_bucket = dir_[index];
-  for (auto &item : target_bucket->GetItems()) {
-    if (item.first == key) {
-      item.second = value;
-      return;
+  // bucket已满，持目录写锁分裂直到能插入，期间没有其他线程访问任何bucket
+  std::unique_lock lock(latch_);
+  while (!dir_[IndexOf(key)]->Insert(key, value)) {
+    SplitBucket(IndexOf(key));
+  }
+}
+
+template <typename K, typename V>
+void ExtendibleHashTable<K, V>::SplitBucket(size_t dir_index) {
+  Bucket *target_bucket = dir_[dir_index];
+  if (target_bucket->GetDepth() == GetGlobalDepthInternal()) {
+    global_depth_++;
+    size_t capacity = dir_.size();
+    dir_.resize(capacity << 1);
+    std::copy(dir_.begin(), dir_.begin() + capacity, dir_.begin() + capacity);
+  }
+  size_t bit = static_cast<size_t>(1) << target_bucket->GetDepth();
+  target_bucket->IncrementDepth();
+  buckets_.emplace_back(std::make_unique<Bucket>(bucket_size_, target_bucket->GetDepth()));
+  Bucket *image = buckets_.back().get();
+  target_bucket->SplitInto(image, bit);
+  num_buckets_++;
+  // 指向该bucket的目录项低depth位相同，步长为bit，其中该位为1的改指向新bucket
+  for (size_t i = dir_index & (bit - 1); i < dir_.size(); i += bit) {
+    if ((i & bit) != 0U) {
+      dir_[i] = image;
     }
   }
-  target_bucket->Insert(key, value);
 }
 
 //===--------------------------------------------------------------------===//
 // Bucket
 //===--------------------------------------------------------------------===//
 template <typename K, typename V>
-ExtendibleHashTable<K, V>::Bucket::Bucket(size_t array_size, int depth) : size_(array_size), depth_(depth) {}
+ExtendibleHashTable<K, V>::Bucket::Bucket(size_t array_size, int depth) : size_(array_size), depth_(depth) {
+  fingerprints_.reserve(array_size);
+  items_.reserve(array_size);
+}
 
 template <typename K, typename V>
-auto ExtendibleHashTable<K, V>::Bucket::Find(const K &key, V &value) -> bool {
-  for (auto it = list_.begin(); it != list_.end(); ++it) {
-    if (it->first == key) {
-      value = it->second;
-      return true;
+auto ExtendibleHashTable<K, V>::Bucket::IndexOf(const K &key, uint8_t fingerprint) const -> int {
+  // 先比较连续存放的指纹，指纹相同才比较key
+  for (size_t i = 0; i < fingerprints_.size(); i++) {
+    if (fingerprints_[i] == fingerprint && items_[i].first == key) {
+      return static_cast<int>(i);
     }
   }
-  return false;
+  return -1;
+}
+
+template <typename K, typename V>
+auto ExtendibleHashTable<K, V>::Bucket::Find(const K &key, V &value) const -> bool {
+  int index = IndexOf(key, Fingerprint(std::hash<K>()(key)));
+  if (index < 0) {
+    return false;
+  }
+  value = items_[index].second;
+  return true;
 }
 
 template <typename K, typename V>
 auto ExtendibleHashTable<K, V>::Bucket::Remove(const K &key) -> bool {
-  auto it = list_.begin();
-  for (; it != list_.end();) {
-    if (it->first == key) {
-      list_.erase(it++);
-      return true;
-    }
-    ++it;
+  int index = IndexOf(key, Fingerprint(std::hash<K>()(key)));
+  if (index < 0) {
+    return false;
   }
-  return false;
+  // 用最后一项填补空位
+  std::swap(fingerprints_[index], fingerprints_.back());
+  std::swap(items_[index], items_.back());
+  fingerprints_.pop_back();
+  items_.pop_back();
+  return true;
 }
 
 template <typename K, typename V>
 auto ExtendibleHashTable<K, V>::Bucket::Insert(const K &key, const V &value) -> bool {
-  //  //Todo : 加锁
-  auto it = list_.begin();
-  for (; it != list_.end(); it++) {
-    if (it->first == key) {
-      it->second = value;
-      return true;
-    }
+  uint8_t fingerprint = Fingerprint(std::hash<K>()(key));
+  int index = IndexOf(key, fingerprint);
+  if (index >= 0) {
+    items_[index].second = value;
+    return true;
   }
-  if (this->IsFull()) {
+  if (IsFull()) {
     return false;
   }
-  list_.emplace_back(std::make_pair(key, value));
+  fingerprints_.push_back(fingerprint);
+  items_.emplace_back(key, value);
   return true;
 }
 
+template <typename K, typename V>
+void ExtendibleHashTable<K, V>::Bucket::SplitInto(Bucket *image, size_t bit) {
+  size_t i = 0;
+  while (i < items_.size()) {
+    if ((std::hash<K>()(items_[i].first) & bit) == 0U) {
+      i++;
+      continue;
+    }
+    image->fingerprints_.push_back(fingerprints_[i]);
+    image->items_.push_back(std::move(items_[i]));
+    std::swap(fingerprints_[i], fingerprints_.back());
+    std::swap(items_[i], items_.back());
+    fingerprints_.pop_back();
+    items_.pop_back();
+  }
+}
+
 template class ExtendibleHashTable<page_id_t, Page *>;
 template class ExtendibleHashTable<Page *, std::list<Page *>::iterator>;
 template class ExtendibleHashTable<int, int>;
@@ -0,0 +1,91 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// bitmap_heap_scan_executor.cpp
+//
+// Identification: src/execution/bitmap_heap_scan_executor.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/executors/bitmap_heap_scan_executor.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace bustub {
+
+namespace {
+
+auto RidLess(const RID &lhs, const RID &rhs) -> bool { return lhs.Get() < rhs.Get(); }
+
+}  // namespace
+
+BitmapHeapScanExecutor::BitmapHeapScanExecutor(ExecutorContext *exec_ctx, const BitmapHeapScanPlanNode *plan)
+    : AbstractExecutor(exec_ctx), plan_{plan}, table_info_{exec_ctx->GetCatalog()->GetTable(plan->GetTableOid())} {}
+
+void BitmapHeapScanExecutor::Init() {
+  rids_.clear();
+  for (uint32_t i = 0; i < plan_->GetChildren().size(); i++) {
+    auto rids = CollectRids(plan_->GetIndexScanAt(i));
+    if (i == 0) {
+      rids_ = std::move(rids);
+      continue;
+    }
+    std::vector<RID> combined;
+    if (plan_->GetCombineType() == BitmapCombineType::And) {
+      std::set_intersection(rids_.begin(), rids_.end(), rids.begin(), rids.end(), std::back_inserter(combined),
+                            RidLess);
+    } else {
+      std::set_union(rids_.begin(), rids_.end(), rids.begin(), rids.end(), std::back_inserter(combined), RidLess);
+    }
+    rids_ = std::move(combined);
+  }
+  next_rid_ = rids_.cbegin();
+  tuples_.clear();
+  tuple_idx_ = 0;
+}
+
+auto BitmapHeapScanExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  while (tuple_idx_ == tuples_.size()) {
+    if (next_rid_ == rids_.cend()) {
+      return false;
+    }
+    // Read all the matches on the next page at once
+    auto page_id = next_rid_->GetPageId();
+    auto page_end = std::find_if(next_rid_, rids_.cend(), [page_id](const RID &rid) {
+      return rid.GetPageId() != page_id;
+    });
+    tuples_.clear();
+    tuple_idx_ = 0;
+    table_info_->table_->GetTuples(next_rid_, page_end, &tuples_, exec_ctx_->GetTransaction());
+    next_rid_ = page_end;
+  }
+  *tuple = tuples_[tuple_idx_++];
+  *rid = tuple->GetRid();
+  return true;
+}
+
+auto BitmapHeapScanExecutor::CollectRids(const IndexScanPlanNode &index_scan) const -> std::vector<RID> {
+  const auto *index_info = exec_ctx_->GetCatalog()->GetIndex(index_scan.GetIndexOid());
+  IndexScanRange range;
+  for (const auto &bound : index_scan.GetLowerBound()) {
+    range.lower_.push_back(bound->Evaluate(nullptr, index_info->key_schema_));
+  }
+  range.lower_inclusive_ = index_scan.lower_inclusive_;
+  for (const auto &bound : index_scan.GetUpperBound()) {
+    range.upper_.push_back(bound->Evaluate(nullptr, index_info->key_schema_));
+  }
+  range.upper_inclusive_ = index_scan.upper_inclusive_;
+
+  // Collect in batches so that no leaf latch is held for the whole range
+  std::vector<RID> rids;
+  while (!index_info->index_->ScanRange(&range, false, INDEX_SCAN_BATCH_SIZE, &rids, nullptr,
+                                        exec_ctx_->GetTransaction())) {
+  }
+  std::sort(rids.begin(), rids.end(), RidLess);
+  rids.erase(std::unique(rids.begin(), rids.end()), rids.end());
+  return rids;
+}
+
+}  // namespace bustub
@@ -39,14 +39,17 @@ auto DeleteExecutor::Next([[maybe_unused]] Tuple *tuple, RID *rid) -> bool {
     bool deleted = table_info_->table_->MarkDelete(emit_rid, exec_ctx_->GetTransaction());
     if (deleted) {
       std::for_each(table_indexes_.begin(), table_indexes_.end(),
-                    [&to_delete_tuple, &rid, &table_info = table_info_, &exec_ctx = exec_ctx_](IndexInfo *index) {
+                    [&to_delete_tuple, &emit_rid, &table_info = table_info_, &exec_ctx = exec_ctx_](IndexInfo *index) {
                       index->index_->DeleteEntry(to_delete_tuple.KeyFromTuple(table_info->schema_, index->key_schema_,
                                                                               index->index_->GetKeyAttrs()),
-                                                 *rid, exec_ctx->GetTransaction());
+                                                 emit_rid, exec_ctx->GetTransaction());
                     });
       delete_count++;
     }
   }
+  for (auto *index_info : table_indexes_) {
+    index_info->RefreshStats(true);
+  }
   std::vector<Value> values{};
   values.reserve(GetOutputSchema().GetColumnCount());
   values.emplace_back(TypeId::INTEGER, delete_count);
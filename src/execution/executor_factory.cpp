@@ -17,6 +17,7 @@
 
 #include "execution/executors/abstract_executor.h"
 #include "execution/executors/aggregation_executor.h"
+#include "execution/executors/bitmap_heap_scan_executor.h"
 #include "execution/executors/delete_executor.h"
 #include "execution/executors/filter_executor.h"
 #include "execution/executors/hash_join_executor.h"
@@ -55,6 +56,12 @@ auto ExecutorFactory::CreateExecutor(ExecutorContext *exec_ctx, const AbstractPl
       return std::make_unique<IndexScanExecutor>(exec_ctx, dynamic_cast<const IndexScanPlanNode *>(plan.get()));
     }
 
+    // Create a new bitmap heap scan executor, its index scan children only describe key ranges
+    case PlanType::BitmapHeapScan: {
+      return std::make_unique<BitmapHeapScanExecutor>(exec_ctx,
+                                                      dynamic_cast<const BitmapHeapScanPlanNode *>(plan.get()));
+    }
+
     // Create a new insert executor
     case PlanType::Insert: {
       auto insert_plan = dynamic_cast<const InsertPlanNode *>(plan.get());
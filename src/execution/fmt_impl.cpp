@@ -7,7 +7,10 @@
 #include "execution/expressions/abstract_expression.h"
 #include "execution/plans/abstract_plan.h"
 #include "execution/plans/aggregation_plan.h"
+#include "execution/plans/bitmap_heap_scan_plan.h"
+#include "execution/plans/index_scan_plan.h"
 #include "execution/plans/limit_plan.h"
+#include "execution/plans/nested_index_join_plan.h"
 #include "execution/plans/projection_plan.h"
 #include "execution/plans/sort_plan.h"
 #include "execution/plans/topn_plan.h"
@@ -43,6 +46,27 @@ auto UpdatePlanNode::PlanNodeToString() const -> std::string {
   return fmt::format("Update {{ table_oid={}, target_exprs={} }}", table_oid_, target_expressions_);
 }
 
+auto IndexScanPlanNode::PlanNodeToString() const -> std::string {
+  auto index_only = index_only_ ? ", index_only=true" : "";
+  if (lower_bound_.empty() && upper_bound_.empty() && !reverse_) {
+    return fmt::format("IndexScan {{ index_oid={}{} }}", index_oid_, index_only);
+  }
+  return fmt::format("IndexScan {{ index_oid={}, range={}{}, {}{}, reverse={}{} }}", index_oid_,
+                     lower_inclusive_ ? "[" : "(", lower_bound_.empty() ? "-inf" : fmt::format("{}", lower_bound_),
+                     upper_bound_.empty() ? "+inf" : fmt::format("{}", upper_bound_), upper_inclusive_ ? "]" : ")",
+                     reverse_, index_only);
+}
+
+auto BitmapHeapScanPlanNode::PlanNodeToString() const -> std::string {
+  return fmt::format("BitmapHeapScan {{ table_oid={}, combine={} }}", table_oid_,
+                     combine_type_ == BitmapCombineType::And ? "and" : "or");
+}
+
+auto NestedIndexJoinPlanNode::PlanNodeToString() const -> std::string {
+  return fmt::format("NestedIndexJoin {{ type={}, key_predicates={}, index={}, index_table={} }}", join_type_,
+                     key_predicates_, index_name_, index_table_name_);
+}
+
 auto SortPlanNode::PlanNodeToString() const -> std::string {
   return fmt::format("Sort {{ order_bys={} }}", order_bys_);
 }
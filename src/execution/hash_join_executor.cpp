@@ -11,6 +11,10 @@
 //===----------------------------------------------------------------------===//
 
 #include "execution/executors/hash_join_executor.h"
+#include "common/config.h"
+#include "common/exception.h"
+#include "common/util/hash_util.h"
+#include "type/value_factory.h"
 
 // Note for 2022 Fall: You don't need to implement HashJoinExecutor to pass all tests. You ONLY need to implement it
 // if you want to get faster in leaderboard tests.
@@ -20,15 +24,312 @@ namespace bustub {
 HashJoinExecutor::HashJoinExecutor(ExecutorContext *exec_ctx, const HashJoinPlanNode *plan,
                                    std::unique_ptr<AbstractExecutor> &&left_child,
                                    std::unique_ptr<AbstractExecutor> &&right_child)
-    : AbstractExecutor(exec_ctx) {
+    : AbstractExecutor(exec_ctx),
+      plan_{plan},
+      left_executor_(std::move(left_child)),
+      right_executor_(std::move(right_child)) {
   if (!(plan->GetJoinType() == JoinType::LEFT || plan->GetJoinType() == JoinType::INNER)) {
     // Note for 2022 Fall: You ONLY need to implement left join and inner join.
     throw bustub::NotImplementedException(fmt::format("join type {} not supported", plan->GetJoinType()));
   }
 }
 
-void HashJoinExecutor::Init() { throw NotImplementedException("HashJoinExecutor is not implemented"); }
+void HashJoinExecutor::Init() {
+  left_executor_->Init();
+  right_executor_->Init();
+  ReleaseTable();
+  pending_.clear();
+  probe_reader_.reset();
+  current_ = {};
+  spilled_ = false;
+  left_drained_ = false;
+  has_left_ = false;
 
-auto HashJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool { return false; }
+  TupleSource next_build = [this](Tuple *tuple) {
+    RID rid{};
+    return right_executor_->Next(tuple, &rid);
+  };
+  TupleSource next_probe = [this](Tuple *tuple) {
+    RID rid{};
+    return left_executor_->Next(tuple, &rid);
+  };
+  if (!CollectBuildSide(next_build, true)) {
+    Spill(next_build, next_probe, 0);
+    spilled_ = true;
+    return;
+  }
+  LayOutTable();
+  if (radix_bits_ > 0) {
+    PartitionProbeSide();
+  }
+}
+
+auto HashJoinExecutor::HashKey(const Value &key) -> uint64_t {
+  // HashUtil mixes its input only weakly, so spread it over the high bits with a Fibonacci multiplication.
+  return static_cast<uint64_t>(HashUtil::HashValue(&key)) * 0x9E3779B97F4A7C15ULL;
+}
+
+auto HashJoinExecutor::CollectBuildSide(const TupleSource &next, bool may_spill) -> bool {
+  const auto &schema = right_executor_->GetOutputSchema();
+  Tuple tuple{};
+  while (next(&tuple)) {
+    auto key = plan_->RightJoinKeyExpression().Evaluate(&tuple, schema);
+    if (key.IsNull()) {
+      // NULL never compares equal, so the row can not be matched by any probe.
+      continue;
+    }
+    // The row, its key, and its entry before and after LayOutTable.
+    size_t bytes = sizeof(Tuple) + tuple.GetLength() + sizeof(Value) + 2 * sizeof(Entry);
+    bool reserved = GetExecutorContext()->ReserveMemory(bytes);
+    if (reserved) {
+      reserved_bytes_ += bytes;
+    }
+    build_entries_.push_back({HashKey(key), static_cast<uint32_t>(build_tuples_.size())});
+    build_tuples_.push_back(tuple);
+    build_keys_.push_back(std::move(key));
+    if (!reserved && may_spill) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void HashJoinExecutor::LayOutTable() {
+  // About one bucket per row, and partitions of at most HASH_JOIN_PARTITION_ROWS rows where the fan-out allows it.
+  uint32_t bucket_bits = 1;
+  while ((size_t{1} << bucket_bits) < build_entries_.size()) {
+    bucket_bits++;
+  }
+  radix_bits_ = 0;
+  while (radix_bits_ < static_cast<uint32_t>(HASH_JOIN_MAX_RADIX_BITS) && radix_bits_ < bucket_bits &&
+         (build_entries_.size() >> radix_bits_) > static_cast<size_t>(HASH_JOIN_PARTITION_ROWS)) {
+    radix_bits_++;
+  }
+  bucket_shift_ = 64 - bucket_bits;
+
+  // Pass 1: scatter the entries into radix partitions. The fan-out is small enough for every partition's write
+  // position to stay cached, and it is skipped entirely when the table is a single partition.
+  std::vector<Entry> partitioned;
+  if (radix_bits_ > 0) {
+    const uint32_t partition_shift = 64 - radix_bits_;
+    std::vector<size_t> positions((size_t{1} << radix_bits_) + 1, 0);
+    for (const auto &entry : build_entries_) {
+      positions[(entry.hash_ >> partition_shift) + 1]++;
+    }
+    for (size_t i = 1; i < positions.size(); i++) {
+      positions[i] += positions[i - 1];
+    }
+    partitioned.resize(build_entries_.size());
+    for (const auto &entry : build_entries_) {
+      partitioned[positions[entry.hash_ >> partition_shift]++] = entry;
+    }
+  } else {
+    partitioned = std::move(build_entries_);
+  }
+  build_entries_.clear();
+  build_entries_.shrink_to_fit();
+
+  // Pass 2: order the entries by bucket. A partition owns a contiguous range of buckets, so while one partition is
+  // being laid out every write lands in the same small region of entries_.
+  offsets_.assign((size_t{1} << bucket_bits) + 1, 0);
+  for (const auto &entry : partitioned) {
+    offsets_[(entry.hash_ >> bucket_shift_) + 1]++;
+  }
+  for (size_t i = 1; i < offsets_.size(); i++) {
+    offsets_[i] += offsets_[i - 1];
+  }
+  std::vector<uint32_t> positions(offsets_.begin(), offsets_.end() - 1);
+  entries_.resize(partitioned.size());
+  for (const auto &entry : partitioned) {
+    entries_[positions[entry.hash_ >> bucket_shift_]++] = entry;
+  }
+}
+
+void HashJoinExecutor::PartitionProbeSide() {
+  const auto &schema = left_executor_->GetOutputSchema();
+  const uint32_t partition_shift = 64 - radix_bits_;
+  std::vector<Entry> scattered;
+  std::vector<size_t> positions((size_t{1} << radix_bits_) + 1, 0);
+  Tuple tuple{};
+  RID rid{};
+  // Rows past the memory budget are not materialized; NextProbeTuple streams them once these have been probed.
+  bool reserved = true;
+  while (reserved) {
+    if (!left_executor_->Next(&tuple, &rid)) {
+      left_drained_ = true;
+      break;
+    }
+    size_t bytes = sizeof(Tuple) + tuple.GetLength() + 2 * sizeof(Entry);
+    reserved = GetExecutorContext()->ReserveMemory(bytes);
+    if (reserved) {
+      reserved_bytes_ += bytes;
+    }
+    auto key = plan_->LeftJoinKeyExpression().Evaluate(&tuple, schema);
+    // A NULL key matches nothing; it still has to be visited once so that a left join can emit it.
+    uint64_t hash = key.IsNull() ? 0 : HashKey(key);
+    positions[(hash >> partition_shift) + 1]++;
+    scattered.push_back({hash, static_cast<uint32_t>(probe_tuples_.size())});
+    probe_tuples_.push_back(tuple);
+  }
+  for (size_t i = 1; i < positions.size(); i++) {
+    positions[i] += positions[i - 1];
+  }
+  probe_entries_.resize(scattered.size());
+  for (const auto &entry : scattered) {
+    probe_entries_[positions[entry.hash_ >> partition_shift]++] = entry;
+  }
+}
+
+void HashJoinExecutor::Spill(const TupleSource &next_build, const TupleSource &next_probe, uint32_t level) {
+  auto *bpm = GetExecutorContext()->GetBufferPoolManager();
+  const size_t fanout = size_t{1} << HASH_JOIN_SPILL_FANOUT_BITS;
+  // Each pass consumes the next HASH_JOIN_SPILL_FANOUT_BITS bits below bit 32, away from the high bits that pick
+  // the radix partition and the bucket once a spilled partition is loaded.
+  const uint32_t shift = 32 - (level + 1) * HASH_JOIN_SPILL_FANOUT_BITS;
+  auto partition_of = [&](uint64_t hash) { return (hash >> shift) & (fanout - 1); };
+
+  std::vector<SpilledPartition> partitions(fanout);
+  for (auto &partition : partitions) {
+    partition.build_ = std::make_unique<TmpTupleRun>(bpm);
+    partition.probe_ = std::make_unique<TmpTupleRun>(bpm);
+    partition.level_ = level;
+  }
+
+  for (size_t row = 0; row < build_tuples_.size(); row++) {
+    partitions[partition_of(HashKey(build_keys_[row]))].build_->Append(build_tuples_[row]);
+  }
+  ReleaseTable();
+  const auto &build_schema = right_executor_->GetOutputSchema();
+  Tuple tuple{};
+  while (next_build(&tuple)) {
+    auto key = plan_->RightJoinKeyExpression().Evaluate(&tuple, build_schema);
+    if (!key.IsNull()) {
+      partitions[partition_of(HashKey(key))].build_->Append(tuple);
+    }
+  }
+  for (auto &partition : partitions) {
+    partition.build_->Finish();
+  }
+
+  const auto &probe_schema = left_executor_->GetOutputSchema();
+  while (next_probe(&tuple)) {
+    auto key = plan_->LeftJoinKeyExpression().Evaluate(&tuple, probe_schema);
+    partitions[key.IsNull() ? 0 : partition_of(HashKey(key))].probe_->Append(tuple);
+  }
+  for (auto &partition : partitions) {
+    partition.probe_->Finish();
+    // Output rows are driven by the probe side, and an inner join needs a build row as well.
+    if (partition.probe_->Size() == 0 || (partition.build_->Size() == 0 && plan_->GetJoinType() == JoinType::INNER)) {
+      continue;
+    }
+    pending_.push_back(std::move(partition));
+  }
+}
+
+auto HashJoinExecutor::LoadNextPartition() -> bool {
+  probe_reader_.reset();
+  current_ = {};
+  ReleaseTable();
+  while (!pending_.empty()) {
+    auto partition = std::move(pending_.back());
+    pending_.pop_back();
+
+    TmpTupleRun::Reader build_reader(partition.build_.get());
+    TupleSource next_build = [&build_reader](Tuple *tuple) { return build_reader.Next(tuple); };
+    if (!CollectBuildSide(next_build, partition.level_ + 1 < static_cast<uint32_t>(HASH_JOIN_MAX_SPILL_DEPTH))) {
+      TmpTupleRun::Reader probe_reader(partition.probe_.get());
+      Spill(next_build, [&probe_reader](Tuple *tuple) { return probe_reader.Next(tuple); }, partition.level_ + 1);
+      continue;
+    }
+    LayOutTable();
+    current_ = std::move(partition);
+    probe_reader_ = std::make_unique<TmpTupleRun::Reader>(current_.probe_.get());
+    return true;
+  }
+  return false;
+}
+
+void HashJoinExecutor::ReleaseTable() {
+  build_tuples_.clear();
+  build_keys_.clear();
+  build_entries_.clear();
+  entries_.clear();
+  offsets_.clear();
+  probe_tuples_.clear();
+  probe_entries_.clear();
+  probe_pos_ = 0;
+  cursor_ = 0;
+  cursor_end_ = 0;
+  GetExecutorContext()->ReleaseMemory(reserved_bytes_);
+  reserved_bytes_ = 0;
+}
+
+auto HashJoinExecutor::NextProbeTuple() -> bool {
+  if (spilled_) {
+    while (probe_reader_ == nullptr || !probe_reader_->Next(&left_tuple_)) {
+      if (!LoadNextPartition()) {
+        return false;
+      }
+    }
+  } else if (probe_pos_ < probe_entries_.size()) {
+    left_tuple_ = std::move(probe_tuples_[probe_entries_[probe_pos_++].row_]);
+  } else {
+    RID rid{};
+    if (left_drained_ || !left_executor_->Next(&left_tuple_, &rid)) {
+      left_drained_ = true;
+      return false;
+    }
+  }
+
+  left_key_ = plan_->LeftJoinKeyExpression().Evaluate(&left_tuple_, left_executor_->GetOutputSchema());
+  cursor_ = 0;
+  cursor_end_ = 0;
+  if (!left_key_.IsNull() && !offsets_.empty()) {
+    left_hash_ = HashKey(left_key_);
+    auto bucket = left_hash_ >> bucket_shift_;
+    cursor_ = offsets_[bucket];
+    cursor_end_ = offsets_[bucket + 1];
+  }
+  has_left_ = true;
+  left_matched_ = false;
+  return true;
+}
+
+auto HashJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  if (!spilled_ && entries_.empty() && plan_->GetJoinType() == JoinType::INNER) {
+    return false;
+  }
+  while (has_left_ || NextProbeTuple()) {
+    while (cursor_ < cursor_end_) {
+      const auto &entry = entries_[cursor_++];
+      if (entry.hash_ == left_hash_ && build_keys_[entry.row_].CompareEquals(left_key_) == CmpBool::CmpTrue) {
+        left_matched_ = true;
+        *tuple = JoinTuples(&build_tuples_[entry.row_]);
+        return true;
+      }
+    }
+    has_left_ = false;
+    if (!left_matched_ && plan_->GetJoinType() == JoinType::LEFT) {
+      *tuple = JoinTuples(nullptr);
+      return true;
+    }
+  }
+  return false;
+}
+
+auto HashJoinExecutor::JoinTuples(const Tuple *right_tuple) const -> Tuple {
+  const auto &left_schema = left_executor_->GetOutputSchema();
+  const auto &right_schema = right_executor_->GetOutputSchema();
+  std::vector<Value> vals;
+  vals.reserve(left_schema.GetColumnCount() + right_schema.GetColumnCount());
+  for (uint32_t idx = 0; idx < left_schema.GetColumnCount(); idx++) {
+    vals.push_back(left_tuple_.GetValue(&left_schema, idx));
+  }
+  for (uint32_t idx = 0; idx < right_schema.GetColumnCount(); idx++) {
+    vals.push_back(right_tuple != nullptr ? right_tuple->GetValue(&right_schema, idx)
+                                          : ValueFactory::GetNullValueByType(right_schema.GetColumn(idx).GetType()));
+  }
+  return {vals, &GetOutputSchema()};
+}
 
 }  // namespace bustub
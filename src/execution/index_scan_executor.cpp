@@ -11,27 +11,81 @@
 //===----------------------------------------------------------------------===//
 #include "execution/executors/index_scan_executor.h"
 #include "execution/expressions/constant_value_expression.h"
+#include "type/value_factory.h"
 
 namespace bustub {
 IndexScanExecutor::IndexScanExecutor(ExecutorContext *exec_ctx, const IndexScanPlanNode *plan)
     : AbstractExecutor(exec_ctx),
       plan_{plan},
       index_info_{this->exec_ctx_->GetCatalog()->GetIndex(plan_->index_oid_)},
-      table_info_{this->exec_ctx_->GetCatalog()->GetTable(index_info_->table_name_)},
-      tree_{dynamic_cast<BPlusTreeIndexForOneIntegerColumn *>(index_info_->index_.get())},
-      iter_{tree_->GetBeginIterator()} {}
+      table_info_{this->exec_ctx_->GetCatalog()->GetTable(index_info_->table_name_)} {}
 
 void IndexScanExecutor::Init() {
+  range_ = {};
+  for (const auto &bound : plan_->lower_bound_) {
+    range_.lower_.push_back(bound->Evaluate(nullptr, index_info_->key_schema_));
+  }
+  range_.lower_inclusive_ = plan_->lower_inclusive_;
+  for (const auto &bound : plan_->upper_bound_) {
+    range_.upper_.push_back(bound->Evaluate(nullptr, index_info_->key_schema_));
+  }
+  range_.upper_inclusive_ = plan_->upper_inclusive_;
+  exhausted_ = false;
+  rids_.clear();
+  entries_.clear();
+  rid_iter_ = rids_.cbegin();
+
+  if (plan_->index_only_) {
+    const auto &entry_attrs = index_info_->index_->GetEntryAttrs();
+    entry_positions_.assign(GetOutputSchema().GetColumnCount(), -1);
+    for (size_t i = 0; i < entry_attrs.size(); i++) {
+      entry_positions_[entry_attrs[i]] = static_cast<int>(i);
+    }
+  }
 }
 
 auto IndexScanExecutor::Next(Tuple *tuple, RID *rid) -> bool {
-  if (iter_ == tree_->GetEndIterator()) {
-    return false;
+  while (true) {
+    if (rid_iter_ == rids_.cend()) {
+      if (exhausted_) {
+        return false;
+      }
+      FetchBatch();
+      continue;
+    }
+    if (plan_->index_only_) {
+      *tuple = TupleFromEntry(entries_[rid_iter_ - rids_.cbegin()]);
+      *rid = *rid_iter_++;
+      return true;
+    }
+    *rid = *rid_iter_++;
+    if (table_info_->table_->GetTuple(*rid, tuple, exec_ctx_->GetTransaction())) {
+      return true;
+    }
+  }
+}
+
+void IndexScanExecutor::FetchBatch() {
+  rids_.clear();
+  entries_.clear();
+  exhausted_ = index_info_->index_->ScanRange(&range_, plan_->reverse_, INDEX_SCAN_BATCH_SIZE, &rids_,
+                                              plan_->index_only_ ? &entries_ : nullptr, exec_ctx_->GetTransaction());
+  rid_iter_ = rids_.cbegin();
+}
+
+auto IndexScanExecutor::TupleFromEntry(const Tuple &entry) const -> Tuple {
+  const auto &schema = GetOutputSchema();
+  const auto *entry_schema = index_info_->index_->GetEntrySchema();
+  std::vector<Value> values;
+  values.reserve(schema.GetColumnCount());
+  for (uint32_t i = 0; i < schema.GetColumnCount(); i++) {
+    if (entry_positions_[i] < 0) {
+      values.push_back(ValueFactory::GetNullValueByType(schema.GetColumn(i).GetType()));
+    } else {
+      values.push_back(entry.GetValue(entry_schema, entry_positions_[i]));
+    }
   }
-  *rid = (*iter_).second;
-  auto result = table_info_->table_->GetTuple(*rid, tuple, exec_ctx_->GetTransaction());
-  ++iter_;
-  return result;
+  return {values, &schema};
 }
 
 }  // namespace bustub
@@ -24,6 +24,8 @@ InsertExecutor::InsertExecutor(ExecutorContext *exec_ctx, const InsertPlanNode *
 void InsertExecutor::Init() {
   child_executor_->Init();
   table_indexes_ = exec_ctx_->GetCatalog()->GetTableIndexes(table_info_->name_);
+  index_keys_.assign(table_indexes_.size(), {});
+  index_rids_.clear();
 }
 
 auto InsertExecutor::Next([[maybe_unused]] Tuple *tuple, RID *rid) -> bool {
@@ -37,15 +39,22 @@ auto InsertExecutor::Next([[maybe_unused]] Tuple *tuple, RID *rid) -> bool {
     bool inserted = table_info_->table_->InsertTuple(to_insert_tuple, rid, exec_ctx_->GetTransaction());
 
     if (inserted) {
-      std::for_each(table_indexes_.begin(), table_indexes_.end(),
-                    [&to_insert_tuple, &rid, &table_info = table_info_, &exec_ctx = exec_ctx_](IndexInfo *index) {
-                      index->index_->InsertEntry(to_insert_tuple.KeyFromTuple(table_info->schema_, index->key_schema_,
-                                                                              index->index_->GetKeyAttrs()),
-                                                 *rid, exec_ctx->GetTransaction());
-                    });
+      for (size_t i = 0; i < table_indexes_.size(); i++) {
+        const auto *index = table_indexes_[i]->index_.get();
+        index_keys_[i].push_back(
+            to_insert_tuple.KeyFromTuple(table_info_->schema_, *index->GetEntrySchema(), index->GetEntryAttrs()));
+      }
+      index_rids_.push_back(*rid);
+      if (index_rids_.size() == static_cast<size_t>(INDEX_BATCH_SIZE)) {
+        FlushIndexBatch();
+      }
       ++insert_count;
     }
   }
+  FlushIndexBatch();
+  for (auto *index_info : table_indexes_) {
+    index_info->RefreshStats(true);
+  }
   std::vector<Value> values{};
   values.reserve(GetOutputSchema().GetColumnCount());
   values.emplace_back(TypeId::INTEGER, insert_count);
@@ -54,4 +63,12 @@ auto InsertExecutor::Next([[maybe_unused]] Tuple *tuple, RID *rid) -> bool {
   return true;
 }
 
+void InsertExecutor::FlushIndexBatch() {
+  for (size_t i = 0; i < table_indexes_.size(); i++) {
+    table_indexes_[i]->index_->InsertBatch(index_keys_[i], index_rids_, exec_ctx_->GetTransaction());
+    index_keys_[i].clear();
+  }
+  index_rids_.clear();
+}
+
 }  // namespace bustub
@@ -22,50 +22,108 @@ NestIndexJoinExecutor::NestIndexJoinExecutor(ExecutorContext *exec_ctx, const Ne
       child_(std::move(child_executor)),
       index_info_{this->exec_ctx_->GetCatalog()->GetIndex(plan_->index_oid_)},
       table_info_{this->exec_ctx_->GetCatalog()->GetTable(index_info_->table_name_)},
-      tree_{dynamic_cast<BPlusTreeIndexForOneIntegerColumn *>(index_info_->index_.get())} {
+      full_key_{plan_->KeyPredicates().size() == index_info_->key_schema_.GetColumnCount()} {
   if (!(plan->GetJoinType() == JoinType::LEFT || plan->GetJoinType() == JoinType::INNER)) {
     // Note for 2022 Fall: You ONLY need to implement left join and inner join.
     throw bustub::NotImplementedException(fmt::format("join type {} not supported", plan->GetJoinType()));
   }
 }
 
-void NestIndexJoinExecutor::Init() { child_->Init(); }
+void NestIndexJoinExecutor::Init() {
+  child_->Init();
+  left_tuples_.clear();
+  left_rids_.clear();
+  left_idx_ = 0;
+}
 
-auto NestIndexJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool { 
-  Tuple left_tuple{};
-  RID emit_rid{};
+auto NestIndexJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  const auto &left_schema = child_->GetOutputSchema();
+  const auto &right_schema = plan_->InnerTableSchema();
   std::vector<Value> vals;
-  while (child_->Next(&left_tuple, &emit_rid)) {
-    Value value = plan_->KeyPredicate()->Evaluate(&left_tuple, child_->GetOutputSchema());
-    std::vector<RID> rids;
-    // index scan the right table
-    tree_->ScanKey(Tuple{{value}, index_info_->index_->GetKeySchema()}, &rids, exec_ctx_->GetTransaction());
-    Tuple right_tuple{};
-    if (!rids.empty()) {
-      // Match, output the result
-      table_info_->table_->GetTuple(rids[0], &right_tuple, exec_ctx_->GetTransaction());
-      for (uint32_t idx = 0; idx < child_->GetOutputSchema().GetColumnCount(); idx++) {
-        vals.push_back(left_tuple.GetValue(&child_->GetOutputSchema(), idx));
+  while (true) {
+    if (left_idx_ == left_tuples_.size()) {
+      if (!ProbeBatch()) {
+        return false;
+      }
+    }
+    const auto &left_tuple = left_tuples_[left_idx_];
+    const auto &rids = left_rids_[left_idx_];
+
+    // Emit the remaining matches of the current outer tuple
+    while (rid_iter_ != rids.cend()) {
+      Tuple right_tuple{};
+      if (!table_info_->table_->GetTuple(*rid_iter_++, &right_tuple, exec_ctx_->GetTransaction())) {
+        continue;
       }
-      for (uint32_t idx = 0; idx < plan_->InnerTableSchema().GetColumnCount(); idx++) {
-        vals.push_back(right_tuple.GetValue(&plan_->InnerTableSchema(), idx));
+      for (uint32_t idx = 0; idx < left_schema.GetColumnCount(); idx++) {
+        vals.push_back(left_tuple.GetValue(&left_schema, idx));
+      }
+      for (uint32_t idx = 0; idx < right_schema.GetColumnCount(); idx++) {
+        vals.push_back(right_tuple.GetValue(&right_schema, idx));
       }
       *tuple = Tuple(vals, &GetOutputSchema());
       return true;
     }
-    // Left join 
-    if (plan_->GetJoinType() == JoinType::LEFT) {
-      for (uint32_t idx = 0; idx < child_->GetOutputSchema().GetColumnCount(); idx++) {
-        vals.push_back(left_tuple.GetValue(&child_->GetOutputSchema(), idx));
+
+    // Move on to the next outer tuple
+    left_idx_++;
+    if (left_idx_ < left_tuples_.size()) {
+      rid_iter_ = left_rids_[left_idx_].cbegin();
+    }
+
+    // Left join
+    if (rids.empty() && plan_->GetJoinType() == JoinType::LEFT) {
+      for (uint32_t idx = 0; idx < left_schema.GetColumnCount(); idx++) {
+        vals.push_back(left_tuple.GetValue(&left_schema, idx));
       }
-      for (uint32_t idx = 0; idx < plan_->InnerTableSchema().GetColumnCount(); idx++) {
-        vals.push_back(ValueFactory::GetNullValueByType(plan_->InnerTableSchema().GetColumn(idx).GetType()));
+      for (uint32_t idx = 0; idx < right_schema.GetColumnCount(); idx++) {
+        vals.push_back(ValueFactory::GetNullValueByType(right_schema.GetColumn(idx).GetType()));
       }
       *tuple = Tuple(vals, &GetOutputSchema());
       return true;
     }
   }
-  return false;
 }
 
-}  // namespace bustub
\ No newline at end of file
+auto NestIndexJoinExecutor::ProbeBatch() -> bool {
+  const auto &left_schema = child_->GetOutputSchema();
+  left_tuples_.clear();
+  left_idx_ = 0;
+  std::vector<std::vector<Value>> keys;
+  Tuple left_tuple{};
+  RID emit_rid{};
+  while (left_tuples_.size() < static_cast<size_t>(INDEX_BATCH_SIZE) && child_->Next(&left_tuple, &emit_rid)) {
+    std::vector<Value> key;
+    key.reserve(plan_->KeyPredicates().size());
+    for (const auto &key_predicate : plan_->KeyPredicates()) {
+      key.push_back(key_predicate->Evaluate(&left_tuple, left_schema));
+    }
+    keys.push_back(std::move(key));
+    left_tuples_.push_back(left_tuple);
+  }
+  if (left_tuples_.empty()) {
+    return false;
+  }
+
+  // index scan the right table, one batched lookup if the whole key is known and a prefix range scan per key otherwise
+  if (full_key_) {
+    std::vector<Tuple> key_tuples;
+    key_tuples.reserve(keys.size());
+    for (const auto &key : keys) {
+      key_tuples.emplace_back(key, &index_info_->key_schema_);
+    }
+    index_info_->index_->LookupBatch(key_tuples, &left_rids_, exec_ctx_->GetTransaction());
+  } else {
+    left_rids_.assign(keys.size(), {});
+    for (size_t i = 0; i < keys.size(); i++) {
+      IndexScanRange range{keys[i], true, keys[i], true};
+      while (!index_info_->index_->ScanRange(&range, false, INDEX_SCAN_BATCH_SIZE, &left_rids_[i], nullptr,
+                                             exec_ctx_->GetTransaction())) {
+      }
+    }
+  }
+  rid_iter_ = left_rids_[0].cbegin();
+  return true;
+}
+
+}  // namespace bustub
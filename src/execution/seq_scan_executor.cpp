@@ -18,15 +18,13 @@ SeqScanExecutor::SeqScanExecutor(ExecutorContext *exec_ctx, const SeqScanPlanNod
   this->table_info_ = this->exec_ctx_->GetCatalog()->GetTable(plan_->table_oid_);
 }
 
-void SeqScanExecutor::Init() { this->table_iter_ = table_info_->table_->Begin(exec_ctx_->GetTransaction()); }
+void SeqScanExecutor::Init() { this->table_iter_ = std::make_unique<TableScanIterator>(table_info_->table_.get()); }
 
 auto SeqScanExecutor::Next(Tuple *tuple, RID *rid) -> bool {
-  if (table_iter_ == table_info_->table_->End()) {
+  if (!table_iter_->Next(tuple)) {
     return false;
   }
-  *tuple = *table_iter_;
   *rid = tuple->GetRid();
-  ++table_iter_;
   return true;
 }
 
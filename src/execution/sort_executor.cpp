@@ -4,48 +4,67 @@ namespace bustub {
 
 SortExecutor::SortExecutor(ExecutorContext *exec_ctx, const SortPlanNode *plan,
                            std::unique_ptr<AbstractExecutor> &&child_executor)
-    : AbstractExecutor(exec_ctx), plan_{plan}, child_{std::move(child_executor)} {}
+    : AbstractExecutor(exec_ctx),
+      plan_{plan},
+      child_{std::move(child_executor)},
+      encoder_(plan_->GetOrderBy(), child_->GetOutputSchema()) {}
 
 void SortExecutor::Init() {
   child_->Init();
+  merger_.reset();
+  runs_.clear();
+  ReleaseBuffer();
+
   Tuple child_tuple{};
   RID child_rid;
   while (child_->Next(&child_tuple, &child_rid)) {
+    auto key = encoder_.Encode(child_tuple);
+    size_t bytes = sizeof(Tuple) + child_tuple.GetLength() + sizeof(std::string) + key.size();
+    bool reserved = GetExecutorContext()->ReserveMemory(bytes);
+    if (!reserved && !child_tuples_.empty()) {
+      SpillBuffer();
+      reserved = GetExecutorContext()->ReserveMemory(bytes);
+    }
+    // A tuple larger than the whole budget still has to be sorted, alone in its run.
+    if (reserved) {
+      reserved_bytes_ += bytes;
+    }
     child_tuples_.push_back(child_tuple);
+    keys_.push_back(std::move(key));
   }
-  std::sort(
-      child_tuples_.begin(), child_tuples_.end(),
-      [order_bys = plan_->order_bys_, schema = child_->GetOutputSchema()](const Tuple &tuple_a, const Tuple &tuple_b) {
-        for (const auto &order_key : order_bys) {
-          switch (order_key.first) {
-            case OrderByType::INVALID:
-            case OrderByType::DEFAULT:
-            case OrderByType::ASC:
-              if (static_cast<bool>(order_key.second->Evaluate(&tuple_a, schema)
-                                        .CompareLessThan(order_key.second->Evaluate(&tuple_b, schema)))) {
-                return true;
-              } else if (static_cast<bool>(order_key.second->Evaluate(&tuple_a, schema)
-                                               .CompareGreaterThan(order_key.second->Evaluate(&tuple_b, schema)))) {
-                return false;
-              }
-              break;
-            case OrderByType::DESC:
-              if (static_cast<bool>(order_key.second->Evaluate(&tuple_a, schema)
-                                        .CompareGreaterThan(order_key.second->Evaluate(&tuple_b, schema)))) {
-                return true;
-              } else if (static_cast<bool>(order_key.second->Evaluate(&tuple_a, schema)
-                                               .CompareLessThan(order_key.second->Evaluate(&tuple_b, schema)))) {
-                return false;
-              }
-              break;
-          }
-        }
-        return false;
-      });
-  child_iter_ = child_tuples_.begin();
+  SortBuffer();
+  if (runs_.empty()) {
+    return;
+  }
+
+  // Every run pins a page while it is merged, so merge the oldest runs into longer ones until few enough remain.
+  while (runs_.size() + 1 > static_cast<size_t>(EXTERNAL_SORT_MERGE_FANOUT)) {
+    std::vector<std::unique_ptr<TmpTupleRun>> group;
+    for (size_t i = 0; i < static_cast<size_t>(EXTERNAL_SORT_MERGE_FANOUT); i++) {
+      group.push_back(std::move(runs_[i]));
+    }
+    runs_.erase(runs_.begin(), runs_.begin() + EXTERNAL_SORT_MERGE_FANOUT);
+    auto merged = std::make_unique<TmpTupleRun>(GetExecutorContext()->GetBufferPoolManager());
+    {
+      Merger merger(this, group, nullptr, nullptr);
+      while (merger.Next(&child_tuple)) {
+        merged->Append(child_tuple);
+      }
+    }
+    merged->Finish();
+    runs_.push_back(std::move(merged));
+  }
+  merger_ = std::make_unique<Merger>(this, runs_, &child_tuples_, &keys_);
 }
 
 auto SortExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  if (merger_ != nullptr) {
+    if (!merger_->Next(tuple)) {
+      return false;
+    }
+    *rid = tuple->GetRid();
+    return true;
+  }
   if (child_iter_ == child_tuples_.end()) {
     return false;
   }
@@ -55,4 +74,118 @@ auto SortExecutor::Next(Tuple *tuple, RID *rid) -> bool {
   return true;
 }
 
+void SortExecutor::SortBuffer() {
+  auto order = SortByKey(keys_);
+  std::vector<Tuple> tuples;
+  std::vector<std::string> keys;
+  tuples.reserve(order.size());
+  keys.reserve(order.size());
+  for (auto row : order) {
+    tuples.push_back(std::move(child_tuples_[row]));
+    keys.push_back(std::move(keys_[row]));
+  }
+  child_tuples_ = std::move(tuples);
+  keys_ = std::move(keys);
+  child_iter_ = child_tuples_.begin();
+}
+
+void SortExecutor::SpillBuffer() {
+  SortBuffer();
+  auto run = std::make_unique<TmpTupleRun>(GetExecutorContext()->GetBufferPoolManager());
+  for (const auto &tuple : child_tuples_) {
+    run->Append(tuple);
+  }
+  run->Finish();
+  runs_.push_back(std::move(run));
+  ReleaseBuffer();
+}
+
+void SortExecutor::ReleaseBuffer() {
+  child_tuples_.clear();
+  keys_.clear();
+  child_iter_ = child_tuples_.begin();
+  GetExecutorContext()->ReleaseMemory(reserved_bytes_);
+  reserved_bytes_ = 0;
+}
+
+SortExecutor::Merger::Merger(const SortExecutor *sort, const std::vector<std::unique_ptr<TmpTupleRun>> &runs,
+                             std::vector<Tuple> *buffer, std::vector<std::string> *buffer_keys)
+    : sort_(sort), buffer_(buffer), buffer_keys_(buffer_keys) {
+  for (const auto &run : runs) {
+    readers_.push_back(std::make_unique<TmpTupleRun::Reader>(run.get()));
+  }
+  if (buffer_ != nullptr) {
+    // The in-memory buffer is the last source and has no reader.
+    readers_.push_back(nullptr);
+  }
+  heads_.resize(readers_.size());
+  head_keys_.resize(readers_.size());
+  valid_.resize(readers_.size());
+  for (size_t source = 0; source < readers_.size(); source++) {
+    Advance(source);
+  }
+
+  // Leaves past the last source are exhausted sources; play the matches bottom-up, keeping the losers.
+  while (leaves_ < readers_.size()) {
+    leaves_ *= 2;
+  }
+  tree_.resize(leaves_);
+  std::vector<size_t> winners(2 * leaves_);
+  for (size_t leaf = 0; leaf < leaves_; leaf++) {
+    winners[leaves_ + leaf] = leaf;
+  }
+  for (size_t node = leaves_ - 1; node >= 1; node--) {
+    auto left = winners[2 * node];
+    auto right = winners[2 * node + 1];
+    bool left_wins = Beats(left, right);
+    winners[node] = left_wins ? left : right;
+    tree_[node] = left_wins ? right : left;
+  }
+  tree_[0] = winners[1];
+}
+
+auto SortExecutor::Merger::Next(Tuple *tuple) -> bool {
+  auto winner = tree_[0];
+  if (winner >= valid_.size() || !valid_[winner]) {
+    return false;
+  }
+  *tuple = std::move(heads_[winner]);
+  Advance(winner);
+  // Replay the winner's path to the root against the losers stored on it.
+  for (size_t node = (leaves_ + winner) / 2; node >= 1; node /= 2) {
+    if (Beats(tree_[node], winner)) {
+      std::swap(tree_[node], winner);
+    }
+  }
+  tree_[0] = winner;
+  return true;
+}
+
+void SortExecutor::Merger::Advance(size_t source) {
+  if (readers_[source] != nullptr) {
+    // Spilled runs hold tuples only; their keys are encoded again once per tuple as they are read back.
+    valid_[source] = readers_[source]->Next(&heads_[source]);
+    if (valid_[source]) {
+      head_keys_[source] = sort_->encoder_.Encode(heads_[source]);
+    }
+    return;
+  }
+  valid_[source] = buffer_pos_ < buffer_->size();
+  if (valid_[source]) {
+    heads_[source] = std::move((*buffer_)[buffer_pos_]);
+    head_keys_[source] = std::move((*buffer_keys_)[buffer_pos_++]);
+  }
+}
+
+auto SortExecutor::Merger::Beats(size_t a, size_t b) const -> bool {
+  bool a_valid = a < valid_.size() && valid_[a];
+  bool b_valid = b < valid_.size() && valid_[b];
+  if (!a_valid || !b_valid) {
+    return a_valid;
+  }
+  // Ties go to the lower source, so equal keys leave in the order of the runs that hold them.
+  int cmp = head_keys_[a].compare(head_keys_[b]);
+  return cmp < 0 || (cmp == 0 && a < b);
+}
+
 }  // namespace bustub
@@ -0,0 +1,180 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// sort_key.cpp
+//
+// Identification: src/execution/sort_key.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/sort_key.h"
+
+#include <algorithm>
+#include <cstring>
+#include <optional>
+
+#include "common/exception.h"
+
+namespace bustub {
+
+namespace {
+
+/** @return the width of a value of `type` in a normalized key, not counting its NULL flag */
+auto ValueWidth(TypeId type) -> std::optional<size_t> {
+  switch (type) {
+    case TypeId::BOOLEAN:
+    case TypeId::TINYINT:
+      return 1;
+    case TypeId::SMALLINT:
+      return 2;
+    case TypeId::INTEGER:
+      return 4;
+    case TypeId::BIGINT:
+    case TypeId::DECIMAL:
+    case TypeId::TIMESTAMP:
+      return 8;
+    default:
+      return std::nullopt;
+  }
+}
+
+void AppendBigEndian(uint64_t bits, size_t width, std::string *key) {
+  for (size_t i = width; i > 0; i--) {
+    key->push_back(static_cast<char>(bits >> ((i - 1) * 8)));
+  }
+}
+
+void AppendValue(const Value &value, std::string *key) {
+  switch (value.GetTypeId()) {
+    case TypeId::BOOLEAN:
+      key->push_back(static_cast<char>(value.GetAs<int8_t>()));
+      return;
+    case TypeId::TINYINT:
+      AppendBigEndian(static_cast<uint8_t>(value.GetAs<int8_t>()) ^ 0x80U, 1, key);
+      return;
+    case TypeId::SMALLINT:
+      AppendBigEndian(static_cast<uint16_t>(value.GetAs<int16_t>()) ^ 0x8000U, 2, key);
+      return;
+    case TypeId::INTEGER:
+      AppendBigEndian(static_cast<uint32_t>(value.GetAs<int32_t>()) ^ 0x80000000U, 4, key);
+      return;
+    case TypeId::BIGINT:
+      AppendBigEndian(static_cast<uint64_t>(value.GetAs<int64_t>()) ^ (uint64_t{1} << 63), 8, key);
+      return;
+    case TypeId::TIMESTAMP:
+      AppendBigEndian(value.GetAs<uint64_t>(), 8, key);
+      return;
+    case TypeId::DECIMAL: {
+      auto number = value.GetAs<double>();
+      uint64_t bits;
+      memcpy(&bits, &number, sizeof(bits));
+      // Negative doubles order backwards by their bits, so invert them; positive ones only need the sign bit set.
+      bits = (bits >> 63) != 0 ? ~bits : bits | (uint64_t{1} << 63);
+      AppendBigEndian(bits, 8, key);
+      return;
+    }
+    case TypeId::VARCHAR: {
+      const char *data = value.GetData();
+      uint32_t length = value.GetLength();
+      // The stored length counts the terminating NUL.
+      if (length > 0 && data[length - 1] == '\0') {
+        length--;
+      }
+      for (uint32_t i = 0; i < length; i++) {
+        key->push_back(data[i]);
+        if (data[i] == '\0') {
+          key->push_back(static_cast<char>(0xFF));
+        }
+      }
+      key->append(2, '\0');
+      return;
+    }
+    default:
+      throw NotImplementedException("type can not be sorted");
+  }
+}
+
+}  // namespace
+
+SortKeyEncoder::SortKeyEncoder(const std::vector<std::pair<OrderByType, AbstractExpressionRef>> &order_bys,
+                               const Schema &schema)
+    : order_bys_(order_bys), schema_(schema) {}
+
+auto SortKeyEncoder::Encode(const Tuple &tuple) const -> std::string {
+  std::string key;
+  for (const auto &[type, expr] : order_bys_) {
+    size_t begin = key.size();
+    auto value = expr->Evaluate(&tuple, schema_);
+    if (value.IsNull()) {
+      key.push_back(1);
+      // A fixed-width key keeps every value at the same offset.
+      key.append(ValueWidth(expr->GetReturnType()).value_or(0), '\0');
+    } else {
+      key.push_back(0);
+      if (value.GetTypeId() != expr->GetReturnType()) {
+        value = value.CastAs(expr->GetReturnType());
+      }
+      AppendValue(value, &key);
+    }
+    if (type == OrderByType::DESC) {
+      for (size_t i = begin; i < key.size(); i++) {
+        key[i] = static_cast<char>(~key[i]);
+      }
+    }
+  }
+  return key;
+}
+
+auto SortKeyPrefix(const std::string &key) -> uint64_t {
+  uint64_t prefix = 0;
+  for (size_t i = 0; i < sizeof(prefix); i++) {
+    prefix = (prefix << 8) | (i < key.size() ? static_cast<uint8_t>(key[i]) : 0);
+  }
+  return prefix;
+}
+
+auto SortByKey(const std::vector<std::string> &keys) -> std::vector<uint32_t> {
+  std::vector<SortEntry> entries(keys.size());
+  bool prefix_is_key = true;
+  for (uint32_t row = 0; row < keys.size(); row++) {
+    entries[row] = {SortKeyPrefix(keys[row]), row};
+    prefix_is_key &= keys[row].size() <= sizeof(uint64_t);
+  }
+
+  if (prefix_is_key) {
+    // LSD radix sort on the prefix bytes, skipping the bytes every key shares.
+    std::vector<SortEntry> scratch(entries.size());
+    for (uint32_t shift = 0; shift < 64; shift += 8) {
+      std::vector<size_t> positions(257, 0);
+      for (const auto &entry : entries) {
+        positions[((entry.prefix_ >> shift) & 0xFF) + 1]++;
+      }
+      if (std::any_of(positions.begin(), positions.end(), [&](size_t count) { return count == entries.size(); })) {
+        continue;
+      }
+      for (size_t i = 1; i < positions.size(); i++) {
+        positions[i] += positions[i - 1];
+      }
+      for (const auto &entry : entries) {
+        scratch[positions[(entry.prefix_ >> shift) & 0xFF]++] = entry;
+      }
+      entries.swap(scratch);
+    }
+  } else {
+    std::sort(entries.begin(), entries.end(), [&keys](const SortEntry &a, const SortEntry &b) {
+      if (a.prefix_ != b.prefix_) {
+        return a.prefix_ < b.prefix_;
+      }
+      return keys[a.row_] < keys[b.row_];
+    });
+  }
+
+  std::vector<uint32_t> order(entries.size());
+  for (size_t i = 0; i < entries.size(); i++) {
+    order[i] = entries[i].row_;
+  }
+  return order;
+}
+
+}  // namespace bustub
@@ -8,44 +8,28 @@ TopNExecutor::TopNExecutor(ExecutorContext *exec_ctx, const TopNPlanNode *plan,
 
 void TopNExecutor::Init() {
   child_->Init();
-  auto cmp = [order_bys = plan_->order_bys_, schema = child_->GetOutputSchema()](const Tuple &a, const Tuple &b) {
-    for (const auto &order_key : order_bys) {
-      switch (order_key.first) {
-        case OrderByType::INVALID:
-        case OrderByType::DEFAULT:
-        case OrderByType::ASC:
-          if (static_cast<bool>(
-                  order_key.second->Evaluate(&a, schema).CompareLessThan(order_key.second->Evaluate(&b, schema)))) {
-            return true;
-          } else if (static_cast<bool>(order_key.second->Evaluate(&a, schema)
-                                           .CompareGreaterThan(order_key.second->Evaluate(&b, schema)))) {
-            return false;
-          }
-          break;
-        case OrderByType::DESC:
-          if (static_cast<bool>(
-                  order_key.second->Evaluate(&a, schema).CompareGreaterThan(order_key.second->Evaluate(&b, schema)))) {
-            return true;
-          } else if (static_cast<bool>(order_key.second->Evaluate(&a, schema)
-                                           .CompareLessThan(order_key.second->Evaluate(&b, schema)))) {
-            return false;
-          }
-          break;
-      }
-    }
-    return false;
+  SortKeyEncoder encoder(plan_->GetOrderBy(), child_->GetOutputSchema());
+  // A max-heap on the normalized key: its top is the last of the best N tuples seen so far.
+  auto cmp = [](const std::pair<std::string, Tuple> &a, const std::pair<std::string, Tuple> &b) {
+    return a.first < b.first;
   };
-  std::priority_queue<Tuple, std::vector<Tuple>, decltype(cmp)> pq(cmp);
+  std::priority_queue<std::pair<std::string, Tuple>, std::vector<std::pair<std::string, Tuple>>, decltype(cmp)> pq(
+      cmp);
   Tuple child_tuple{};
   RID child_rid;
   while (child_->Next(&child_tuple, &child_rid)) {
-    pq.push(child_tuple);
-    if (pq.size() > plan_->GetN()) {
+    auto key = encoder.Encode(child_tuple);
+    if (pq.size() == plan_->GetN()) {
+      // Most tuples of a long input lose against the current top and are dropped without being copied.
+      if (pq.empty() || key >= pq.top().first) {
+        continue;
+      }
       pq.pop();
     }
+    pq.emplace(std::move(key), child_tuple);
   }
   while (!pq.empty()) {
-    child_tuples_.push(pq.top());
+    child_tuples_.push(pq.top().second);
     pq.pop();
   }
 }
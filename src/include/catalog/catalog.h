@@ -13,6 +13,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>  // NOLINT
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -24,6 +25,7 @@
 #include "storage/index/b_plus_tree_index.h"
 #include "storage/index/extendible_hash_table_index.h"
 #include "storage/index/index.h"
+#include "storage/index/linear_probe_hash_table_index.h"
 #include "storage/table/table_heap.h"
 
 namespace bustub {
@@ -58,6 +60,12 @@ struct TableInfo {
   const table_oid_t oid_;
 };
 
+/**
+ * The access methods an index can be built with, a B-link tree is a B+ tree in B-link mode. A hash index is an
+ * extendible hash table, or a linear probing one with Swiss-table block pages.
+ */
+enum class IndexType { BPlusTreeIndex, BLinkTreeIndex, HashTableIndex, LinearProbeHashIndex };
+
 /**
  * The IndexInfo class maintains metadata about a index.
  */
@@ -70,15 +78,55 @@ struct IndexInfo {
    * @param index_oid The unique OID for the index
    * @param table_name The name of the table on which the index is created
    * @param key_size The size of the index key, in bytes
+   * @param index_type The access method of the index
    */
   IndexInfo(Schema key_schema, std::string name, std::unique_ptr<Index> &&index, index_oid_t index_oid,
-            std::string table_name, size_t key_size)
+            std::string table_name, size_t key_size, IndexType index_type = IndexType::BPlusTreeIndex)
       : key_schema_{std::move(key_schema)},
         name_{std::move(name)},
         index_{std::move(index)},
         index_oid_{index_oid},
         table_name_{std::move(table_name)},
-        key_size_{key_size} {}
+        key_size_{key_size},
+        index_type_{index_type} {}
+
+  /** @return true for a hash index, which only answers lookups of a whole key and keeps no key order */
+  auto IsHash() const -> bool {
+    return index_type_ == IndexType::HashTableIndex || index_type_ == IndexType::LinearProbeHashIndex;
+  }
+
+  /**
+   * @return The statistics of the index. The shape counters are always current, the histogram and the distinct
+   * count come from the last sample. Planning never walks the leaves, the sample is taken by RefreshStats().
+   */
+  auto GetStats() -> IndexStats {
+    auto stats = index_->CollectStats(0);
+    std::scoped_lock lock(stats_latch_);
+    stats.distinct_keys_ = stats_.distinct_keys_;
+    stats.histogram_bounds_ = stats_.histogram_bounds_;
+    return stats;
+  }
+
+  /**
+   * Sample the histogram and the distinct count again. CREATE INDEX samples the new index, the statements that
+   * write an index sample it again once a tenth of its entries has changed since the last sample.
+   * @param only_if_stale skip the sample unless a tenth of the entries has changed
+   */
+  void RefreshStats(bool only_if_stale = false) {
+    auto modifications = index_->GetModificationCount();
+    if (only_if_stale) {
+      std::scoped_lock lock(stats_latch_);
+      if ((modifications - stats_modifications_) * 10 <= stats_.entry_count_) {
+        return;
+      }
+    }
+    // walk the leaves outside the latch, planners keep reading the previous sample meanwhile
+    auto stats = index_->CollectStats(INDEX_HISTOGRAM_BUCKETS);
+    std::scoped_lock lock(stats_latch_);
+    stats_ = std::move(stats);
+    stats_modifications_ = modifications;
+  }
+
   /** The schema for the index key */
   Schema key_schema_;
   /** The name of the index */
@@ -91,6 +139,15 @@ struct IndexInfo {
   std::string table_name_;
   /** The size of the index key, in bytes */
   const size_t key_size_;
+  /** The access method of the index, a hash index only answers lookups of a whole key */
+  const IndexType index_type_;
+
+ private:
+  std::mutex stats_latch_;
+  /** The statistics of the last histogram sample */
+  IndexStats stats_;
+  /** The modification count of the index when it was last sampled */
+  size_t stats_modifications_{0};
 };
 
 /**
@@ -196,12 +253,15 @@ class Catalog {
    * @param key_attrs Key attributes
    * @param keysize Size of the key
    * @param hash_function The hash function for the index
+   * @param include_attrs Non-key attributes stored in every index entry
+   * @param index_type The access method of the index, a hash index cannot store non-key attributes
    * @return A (non-owning) pointer to the metadata of the new table
    */
   template <class KeyType, class ValueType, class KeyComparator>
   auto CreateIndex(Transaction *txn, const std::string &index_name, const std::string &table_name, const Schema &schema,
                    const Schema &key_schema, const std::vector<uint32_t> &key_attrs, std::size_t keysize,
-                   HashFunction<KeyType> hash_function) -> IndexInfo * {
+                   HashFunction<KeyType> hash_function, const std::vector<uint32_t> &include_attrs = {},
+                   IndexType index_type = IndexType::BPlusTreeIndex) -> IndexInfo * {
     // Reject the creation request for nonexistent table
     if (table_names_.find(table_name) == table_names_.end()) {
       return NULL_INDEX_INFO;
@@ -218,30 +278,42 @@ class Catalog {
     }
 
     // Construct index metdata
-    auto meta = std::make_unique<IndexMetadata>(index_name, table_name, &schema, key_attrs);
+    auto meta = std::make_unique<IndexMetadata>(index_name, table_name, &schema, key_attrs, include_attrs);
 
     // Construct the index, take ownership of metadata
-    // TODO(Kyle): We should update the API for CreateIndex
-    // to allow specification of the index type itself, not
-    // just the key, value, and comparator types
-
-    // TODO(chi): support both hash index and btree index
-    auto index = std::make_unique<BPlusTreeIndex<KeyType, ValueType, KeyComparator>>(std::move(meta), bpm_);
+    std::unique_ptr<Index> index;
+    if ((index_type == IndexType::HashTableIndex || index_type == IndexType::LinearProbeHashIndex) &&
+        !include_attrs.empty()) {
+      return NULL_INDEX_INFO;
+    }
+    if (index_type == IndexType::HashTableIndex) {
+      index = std::make_unique<ExtendibleHashTableIndex<KeyType, ValueType, KeyComparator>>(std::move(meta), bpm_,
+                                                                                            hash_function);
+    } else if (index_type == IndexType::LinearProbeHashIndex) {
+      // start with a single block page, the table doubles as it fills
+      index = std::make_unique<LinearProbeHashTableIndex<KeyType, ValueType, KeyComparator>>(std::move(meta), bpm_, 0,
+                                                                                             hash_function);
+    } else {
+      index = std::make_unique<BPlusTreeIndex<KeyType, ValueType, KeyComparator>>(
+          std::move(meta), bpm_, index_type == IndexType::BLinkTreeIndex);
+    }
 
     // Populate the index with all tuples in table heap
     auto *table_meta = GetTable(table_name);
     auto *heap = table_meta->table_.get();
     for (auto tuple = heap->Begin(txn); tuple != heap->End(); ++tuple) {
-      index->InsertEntry(tuple->KeyFromTuple(schema, key_schema, key_attrs), tuple->GetRid(), txn);
+      index->InsertEntry(tuple->KeyFromTuple(schema, *index->GetEntrySchema(), index->GetEntryAttrs()), tuple->GetRid(),
+                         txn);
     }
 
     // Get the next OID for the new index
     const auto index_oid = next_index_oid_.fetch_add(1);
 
     // Construct index information; IndexInfo takes ownership of the Index itself
-    auto index_info =
-        std::make_unique<IndexInfo>(key_schema, index_name, std::move(index), index_oid, table_name, keysize);
+    auto index_info = std::make_unique<IndexInfo>(key_schema, index_name, std::move(index), index_oid, table_name,
+                                                  keysize, index_type);
     auto *tmp = index_info.get();
+    tmp->RefreshStats();
 
     // Update internal tracking
     indexes_.emplace(index_oid, std::move(index_info));
@@ -298,7 +370,7 @@ class Catalog {
    * @param index_oid The OID of the index for which to query
    * @return A (non-owning) pointer to the metadata for the index
    */
-  auto GetIndex(index_oid_t index_oid) -> IndexInfo * {
+  auto GetIndex(index_oid_t index_oid) const -> IndexInfo * {
     auto index = indexes_.find(index_oid);
     if (index == indexes_.end()) {
       return NULL_INDEX_INFO;
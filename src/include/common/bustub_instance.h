@@ -266,6 +266,12 @@ class BustubInstance {
     return variable == "1" || variable == "true" || variable == "yes";
   }
 
+  /** @return the memory budget set with `set execution_memory_budget=<bytes>`, or 0 if there is none */
+  auto GetExecutionMemoryBudget() -> size_t {
+    auto variable = GetSessionVariable("execution_memory_budget");
+    return variable.empty() ? 0 : std::stoull(variable);
+  }
+
  private:
   void CmdDisplayTables(ResultWriter &writer);
   void CmdDisplayIndices(ResultWriter &writer);
@@ -36,6 +36,16 @@ static constexpr int BUFFER_POOL_SIZE = 10;
 static constexpr int LOG_BUFFER_SIZE = ((BUFFER_POOL_SIZE + 1) * BUSTUB_PAGE_SIZE);  // size of a log buffer in byte
 static constexpr int BUCKET_SIZE = 50;                                               // size of extendible hash bucket
 static constexpr int LRUK_REPLACER_K = 10;  // lookback window for lru-k replacer
+static constexpr int INDEX_SCAN_BATCH_SIZE = 128;  // rids an index scan collects before releasing the leaf latch
+static constexpr int INDEX_BATCH_SIZE = 128;       // keys an executor hands to a batched index insert or lookup
+static constexpr int INDEX_HISTOGRAM_BUCKETS = 32;  // buckets of the equi-depth histogram kept for every index
+static constexpr int BLINK_PINNED_POOL_DIVISOR = 8;  // a B-link tree pins at most pool_size / 8 frames for its top levels
+static constexpr int HASH_JOIN_PARTITION_ROWS = 16384;  // build rows per radix partition, so a partition fits in L2
+static constexpr int HASH_JOIN_MAX_RADIX_BITS = 8;      // a hash join splits its input into at most 2^8 partitions
+static constexpr int HASH_JOIN_SPILL_FANOUT_BITS = 4;   // a spilling hash join splits each input into 2^4 runs per pass
+static constexpr int HASH_JOIN_MAX_SPILL_DEPTH = 4;     // partitions still too large after 4 passes are joined in memory
+static constexpr size_t EXECUTOR_MEMORY_BUDGET = 64 << 20;  // bytes a query's operators may hold before they spill
+static constexpr int EXTERNAL_SORT_MERGE_FANOUT = 32;  // runs a sort merges at once, each pins a page while read
 
 using frame_id_t = int32_t;    // frame id type
 using page_id_t = int32_t;     // page id type
@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <optional>
 #include <queue>
 #include <string>
 #include <vector>
@@ -136,6 +137,32 @@ class DiskExtendibleHashTable {
    */
   auto FetchBucketPage(page_id_t bucket_page_id) -> HASH_TABLE_BUCKET_TYPE *;
 
+  /**
+   * Creates an empty bucket page. The caller unpins it.
+   *
+   * @param[out] bucket_page_id the page_id of the new page
+   * @return a pointer to the new bucket page
+   */
+  auto NewBucketPage(page_id_t *bucket_page_id) -> HASH_TABLE_BUCKET_TYPE *;
+
+  /**
+   * Inserts a pair into a bucket and its overflow pages. The caller holds the
+   * write latch of the bucket's primary page, which covers the whole chain.
+   *
+   * @param bucket_page the primary page of the bucket
+   * @param key the key to insert
+   * @param value the value to insert
+   * @param append whether to chain a new overflow page when every page of the bucket is full
+   * @return true if inserted, false for a duplicate pair, nullopt if the bucket is full and append is false
+   */
+  auto InsertIntoChain(HASH_TABLE_BUCKET_TYPE *bucket_page, const KeyType &key, const ValueType &value, bool append)
+      -> std::optional<bool>;
+
+  /**
+   * @return true if the bucket holds no pair, i.e. its primary page is empty and has no overflow page
+   */
+  auto IsBucketEmpty(page_id_t bucket_page_id) -> bool;
+
   /**
    * Performs insertion with an optional bucket splitting.
    *
@@ -148,10 +175,11 @@ class DiskExtendibleHashTable {
 
   /**
    * Optionally merges an empty bucket into it's pair.  This is called by Remove,
-   * if Remove makes a bucket empty.
+   * if Remove makes a bucket empty. The merged bucket is merged again with its
+   * own pair while one of the two is empty, then the directory is shrunk.
    *
    * There are three conditions under which we skip the merge:
-   * 1. The bucket is no longer empty.
+   * 1. Neither the bucket nor its split image is empty.
    * 2. The bucket has local depth 0.
    * 3. The bucket's local depth doesn't match its split image's local depth.
    *
@@ -24,12 +24,17 @@
 
 namespace bustub {
 
-#define HASH_TABLE_TYPE LinearProbeHashTable<KeyType, ValueType, KeyComparator>
+#define LINEAR_PROBE_HASH_TABLE_TYPE LinearProbeHashTable<KeyType, ValueType, KeyComparator>
 
 /**
  * Implementation of linear probing hash table that is backed by a buffer pool
  * manager. Non-unique keys are supported. Supports insert and delete. The
  * table dynamically grows once full.
+ *
+ * The slots of all block pages form one array of groups, Swiss-table style. The high bits of the hash of a key pick
+ * the group its probe starts at, the low 7 bits are the fingerprint kept in the control byte of its slot. A probe
+ * compares the fingerprints of a whole group at once and walks on to the next group only while the group has no
+ * empty slot, so most lookups read the control bytes of one group and a single key.
  */
 template <typename KeyType, typename ValueType, typename KeyComparator>
 class LinearProbeHashTable {
@@ -85,11 +90,35 @@ class LinearProbeHashTable {
   auto GetSize() -> size_t;
 
  private:
+  /** Number of slot groups in a block page */
+  static constexpr size_t GROUPS_PER_BLOCK = BLOCK_ARRAY_SIZE / BLOCK_GROUP_SIZE;
+
   auto GetHeaderPage() -> HashTableHeaderPage *;
   auto GetBlockPage(page_id_t block_page_id) -> HASH_TABLE_BLOCK_TYPE *;
-  void ResizeInsert(HashTableHeaderPage *header_page, const KeyType &key, const ValueType &value);
-  void DeleteBlockPages(HashTableHeaderPage *old_header_page);
-  void CreateNewBlockPages(HashTableHeaderPage *header_page, size_t num_blocks);
+
+  /**
+   * Calls visit(block_page_id, block_page, group, &dirty) for the groups of the probe sequence of a hash, starting at
+   * the group the hash picks, until visit returns true or every group was visited.
+   */
+  template <typename Visitor>
+  void Probe(uint64_t hash, Visitor &&visit);
+
+  /**
+   * Creates the header and block pages of an empty table of at least num_buckets slots and makes it the current
+   * table. The pages of the previous table are left alone.
+   */
+  void CreateTable(size_t num_buckets);
+  /** Deletes the header pages of the chain starting at the given header page and the given block pages */
+  void DeleteTablePages(page_id_t header_page_id, const std::vector<page_id_t> &block_page_ids);
+  /** Moves every pair into a new table of at least num_buckets slots, which also drops the tombstones */
+  void Rebuild(size_t num_buckets);
+
+  /**
+   * Inserts a pair into the first free slot of its probe sequence without updating the counts of the header page.
+   * @param[out] reused_tombstone whether the pair took the slot of a tombstone
+   * @return false if the table already holds the pair
+   */
+  auto InsertLatchFree(const KeyType &key, const ValueType &value, bool *reused_tombstone) -> bool;
   auto GetValueLatchFree(Transaction *transaction, const KeyType &key, std::vector<ValueType> *result) -> bool;
 
   // member variable
@@ -97,11 +126,14 @@ class LinearProbeHashTable {
   BufferPoolManager *buffer_pool_manager_;
   KeyComparator comparator_;
 
-  // Readers includes inserts and removes, writer is only resize
+  // Readers are lookups, writers are inserts, removes and resizes
   ReaderWriterLatch table_latch_;
 
   // Hash function
   HashFunction<KeyType> hash_fn_;
+
+  // The block page ids of all header pages in order, so that a probe goes straight to its block page
+  std::vector<page_id_t> block_page_ids_;
 };
 
 }  // namespace bustub
@@ -17,9 +17,11 @@
 
 #pragma once
 
+#include <cstdint>
 #include <list>
 #include <memory>
 #include <mutex>  // NOLINT
+#include <shared_mutex>
 #include <utility>
 #include <vector>
 
@@ -29,6 +31,8 @@ namespace bustub {
 
 /**
  * ExtendibleHashTable implements a hash table using the extendible hashing algorithm.
+ * It is safe to use from several threads: readers of different buckets and writers of different buckets
+ * proceed in parallel, only bucket splits exclude everyone.
  * @tparam K key type
  * @tparam V value type
  */
@@ -107,13 +111,17 @@ class ExtendibleHashTable : public HashTable<K, V> {
 
   /**
    * Bucket class for each hash table bucket that the directory points to.
+   *
+   * The entries live in a flat array next to an array of one-byte fingerprints of their hashes. A lookup scans the
+   * fingerprints and only compares the keys whose fingerprint matches. Each bucket has its own latch, buckets are
+   * aligned to a cache line so that the latches of neighbouring buckets do not share one.
    */
-  class Bucket {
+  class alignas(64) Bucket {
    public:
     explicit Bucket(size_t size, int depth = 0);
 
     /** @brief Check if a bucket is full. */
-    inline auto IsFull() const -> bool { return list_.size() == size_; }
+    inline auto IsFull() const -> bool { return items_.size() == size_; }
 
     /** @brief Get the local depth of the bucket. */
     inline auto GetDepth() const -> int { return depth_; }
@@ -121,33 +129,28 @@ class ExtendibleHashTable : public HashTable<K, V> {
     /** @brief Increment the local depth of a bucket. */
     inline void IncrementDepth() { depth_++; }
 
-    inline auto GetItems() -> std::list<std::pair<K, V>> & { return list_; }
+    inline auto GetItems() const -> const std::vector<std::pair<K, V>> & { return items_; }
+
+    /** @brief The latch protecting the entries of the bucket, taken under the directory latch. */
+    inline auto GetLatch() const -> std::shared_mutex & { return latch_; }
 
     /**
-     *
-     * TODO(P1): Add implementation
-     *
      * @brief Find the value associated with the given key in the bucket.
      * @param key The key to be searched.
      * @param[out] value The value associated with the key.
      * @return True if the key is found, false otherwise.
      */
-    auto Find(const K &key, V &value) -> bool;
+    auto Find(const K &key, V &value) const -> bool;
 
     /**
-     *
-     * TODO(P1): Add implementation
-     *
      * @brief Given the key, remove the corresponding key-value pair in the bucket.
+     * The last entry takes the place of the removed one.
      * @param key The key to be deleted.
      * @return True if the key exists, false otherwise.
      */
     auto Remove(const K &key) -> bool;
 
     /**
-     *
-     * TODO(P1): Add implementation
-     *
      * @brief Insert the given key-value pair into the bucket.
      *      1. If a key already exists, the value should be updated.
      *      2. If the bucket is full, do nothing and return false.
@@ -157,41 +160,62 @@ class ExtendibleHashTable : public HashTable<K, V> {
      */
     auto Insert(const K &key, const V &value) -> bool;
 
+    /**
+     * @brief Move the entries whose hash has the given bit set into the split image of this bucket.
+     * @param image The empty bucket that takes over the upper half of the hash range.
+     * @param bit The hash bit that tells the two halves apart.
+     */
+    void SplitInto(Bucket *image, size_t bit);
+
    private:
-    // TODO(student): You may add additional private members and helper functions
+    /** @return the index of the key in the entry array, or -1 if it is not in the bucket */
+    auto IndexOf(const K &key, uint8_t fingerprint) const -> int;
+
     size_t size_;
     int depth_;
-    std::list<std::pair<K, V>> list_;
+    /** Fingerprint of the hash of every entry, in entry order */
+    std::vector<uint8_t> fingerprints_;
+    std::vector<std::pair<K, V>> items_;
+    mutable std::shared_mutex latch_;
   };
 
  private:
-  // TODO(student): You may add additional private members and helper functions and remove the ones
-  // you don't need.
-
+  /**
+   * The directory latch is held shared by every lookup, insert and removal, and exclusively while a bucket is split.
+   * Under the shared directory latch, a bucket is latched shared by Find and exclusively by Insert and Remove.
+   * An insert into a full bucket releases both latches and retries under the exclusive directory latch.
+   */
   int global_depth_;    // The global depth of the directory
   size_t bucket_size_;  // The size of a bucket
   int num_buckets_;     // The number of buckets in the hash table
-  mutable std::mutex latch_;
-  std::vector<std::shared_ptr<Bucket>> dir_;  // The directory of the hash table
-
-  // The following functions are completely optional, you can delete them if you have your own ideas.
-
-  /**+
-   * @brief Redistribute the kv pairs in a full bucket.
-   * @param bucket The bucket to be redistributed.
-   */
-  auto RedistributeBucket(std::shared_ptr<Bucket> bucket) -> void;
+  mutable std::shared_mutex latch_;
+  std::vector<std::unique_ptr<Bucket>> buckets_;  // The buckets of the hash table, in creation order
+  std::vector<Bucket *> dir_;                     // The directory of the hash table
 
   /*****************************************************************
    * Must acquire latch_ first before calling the below functions. *
    *****************************************************************/
 
+  /**
+   * @brief Split the bucket that the given directory index points to, doubling the directory if needed.
+   * Only the directory slots that alias the bucket are redirected.
+   * Must hold latch_ exclusively.
+   * @param dir_index A directory index pointing to the bucket.
+   */
+  void SplitBucket(size_t dir_index);
+
   /**
    * @brief For the given key, return the entry index in the directory where the key hashes to.
    * @param key The key to be hashed.
    * @return The entry index in the directory.
    */
-  auto IndexOf(const K &key) -> size_t;
+  auto IndexOf(const K &key) const -> size_t;
+
+  /** @return the one-byte fingerprint of a hash, taken from the high bits of the mixed hash as the directory uses
+   * the low bits */
+  static auto Fingerprint(size_t hash) -> uint8_t {
+    return static_cast<uint8_t>((static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15ULL) >> 56);
+  }
 
   auto GetGlobalDepthInternal() const -> int;
   auto GetLocalDepthInternal(int dir_index) const -> int;
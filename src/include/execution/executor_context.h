@@ -60,6 +60,27 @@ class ExecutorContext {
   /** @return the transaction manager */
   auto GetTransactionManager() -> TransactionManager * { return txn_mgr_; }
 
+  /** @return the number of bytes the query's operators may hold in memory before they spill */
+  auto GetMemoryBudget() const -> size_t { return memory_budget_; }
+
+  /** Set the number of bytes the query's operators may hold in memory */
+  void SetMemoryBudget(size_t memory_budget) { memory_budget_ = memory_budget; }
+
+  /**
+   * Account for `bytes` more memory held by an operator of the query.
+   * @return false, without reserving anything, if that would exceed the budget
+   */
+  auto ReserveMemory(size_t bytes) -> bool {
+    if (memory_used_ + bytes > memory_budget_) {
+      return false;
+    }
+    memory_used_ += bytes;
+    return true;
+  }
+
+  /** Return memory reserved with ReserveMemory */
+  void ReleaseMemory(size_t bytes) { memory_used_ -= bytes; }
+
  private:
   /** The transaction context associated with this executor context */
   Transaction *transaction_;
@@ -71,6 +92,9 @@ class ExecutorContext {
   TransactionManager *txn_mgr_;
   /** The lock manager associated with this executor context */
   LockManager *lock_mgr_;
+  /** Bytes the query's operators may hold, and bytes they currently hold */
+  size_t memory_budget_{EXECUTOR_MEMORY_BUDGET};
+  size_t memory_used_{0};
 };
 
 }  // namespace bustub
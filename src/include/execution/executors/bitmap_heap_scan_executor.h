@@ -0,0 +1,58 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// bitmap_heap_scan_executor.h
+//
+// Identification: src/include/execution/executors/bitmap_heap_scan_executor.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "common/rid.h"
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/plans/bitmap_heap_scan_plan.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * BitmapHeapScanExecutor reads the tuples matched by one or more index range scans in RID order,
+ * fetching every heap page once.
+ */
+class BitmapHeapScanExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Creates a new bitmap heap scan executor.
+   * @param exec_ctx the executor context
+   * @param plan the bitmap heap scan plan to be executed
+   */
+  BitmapHeapScanExecutor(ExecutorContext *exec_ctx, const BitmapHeapScanPlanNode *plan);
+
+  auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
+
+  /** Collect and combine the RIDs of all index scans. */
+  void Init() override;
+
+  auto Next(Tuple *tuple, RID *rid) -> bool override;
+
+ private:
+  /** @return the RIDs in the key range of an index scan, sorted and without duplicates */
+  auto CollectRids(const IndexScanPlanNode &index_scan) const -> std::vector<RID>;
+
+  /** The bitmap heap scan plan node to be executed. */
+  const BitmapHeapScanPlanNode *plan_;
+  const TableInfo *table_info_;
+  /** The combined RIDs in physical order. */
+  std::vector<RID> rids_;
+  /** The first RID on the next page to read. */
+  std::vector<RID>::const_iterator next_rid_{};
+  /** Tuples read from the current page. */
+  std::vector<Tuple> tuples_;
+  size_t tuple_idx_{0};
+};
+}  // namespace bustub
@@ -12,18 +12,34 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/hash_join_plan.h"
+#include "storage/table/tmp_tuple_run.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
 /**
- * HashJoinExecutor executes a nested-loop JOIN on two tables.
+ * HashJoinExecutor executes an equi-JOIN on two tables with an in-memory hash table built on the right child.
+ *
+ * The hash table is flat: every build row is one (hash, row) entry, and the entries are ordered by bucket so a
+ * bucket is a contiguous run found through an offset array. Keys are only compared when the stored hashes are equal.
+ * The bucket is taken from the high bits of the hash. Once the build side has more than HASH_JOIN_PARTITION_ROWS rows,
+ * the top bits of the bucket number also name a radix partition: the build entries are scattered partition by
+ * partition, the probe side is materialized and grouped the same way, and the probe then visits one partition at a
+ * time so the part of the table it touches stays in L2. Output order is only preserved for small build sides.
+ *
+ * The table's rows are charged to the query's memory budget (ExecutorContext::ReserveMemory). If the build side does
+ * not fit, the join turns into a grace hash join: both inputs are hashed into 2^HASH_JOIN_SPILL_FANOUT_BITS pairs of
+ * TmpTupleRuns, and the pairs are joined one at a time. A pair whose build run still does not fit is partitioned
+ * again on the next hash bits, up to HASH_JOIN_MAX_SPILL_DEPTH passes; after that it is joined in memory regardless,
+ * since a partition that large is made of duplicate keys no further pass can split.
  */
 class HashJoinExecutor : public AbstractExecutor {
  public:
@@ -51,9 +67,94 @@ class HashJoinExecutor : public AbstractExecutor {
   /** @return The output schema for the join */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); };
 
+  ~HashJoinExecutor() override { ReleaseTable(); }
+
  private:
-  /** The NestedLoopJoin plan node to be executed. */
+  /** One build (or partitioned probe) row: its mixed key hash and its position in the row array */
+  struct Entry {
+    uint64_t hash_;
+    uint32_t row_;
+  };
+
+  /** The build and probe rows of one spilled hash partition, and the number of passes that produced it */
+  struct SpilledPartition {
+    std::unique_ptr<TmpTupleRun> build_;
+    std::unique_ptr<TmpTupleRun> probe_;
+    uint32_t level_{0};
+  };
+
+  /** Produces the next input tuple, returns false when there is none */
+  using TupleSource = std::function<bool(Tuple *)>;
+
+  /** @return the hash of a join key, mixed so that its high bits are usable as a bucket number */
+  static auto HashKey(const Value &key) -> uint64_t;
+
+  /**
+   * Pull build rows from `next` into memory.
+   * @param may_spill whether to stop once the memory budget is used up
+   * @return false if it stopped for the budget, with rows left in `next`
+   */
+  auto CollectBuildSide(const TupleSource &next, bool may_spill) -> bool;
+
+  /** Lay the collected build rows out as the hash table, bucket by bucket, one radix partition at a time. */
+  void LayOutTable();
+
+  /** Materialize left rows grouped by radix partition, as many as the memory budget allows. */
+  void PartitionProbeSide();
+
+  /** Write the rows held in memory and the rest of both sources into a new set of spilled partitions. */
+  void Spill(const TupleSource &next_build, const TupleSource &next_probe, uint32_t level);
+
+  /** Build the table for the next spilled partition. @return false once every partition has been joined */
+  auto LoadNextPartition() -> bool;
+
+  /** Drop the rows held in memory and return their memory to the budget. */
+  void ReleaseTable();
+
+  /** Load the next left tuple and the bucket range it has to scan. @return false once the left side is exhausted */
+  auto NextProbeTuple() -> bool;
+
+  /** @return the output tuple for the current left tuple and `right_tuple`, or right-side NULLs if it is nullptr */
+  auto JoinTuples(const Tuple *right_tuple) const -> Tuple;
+
+  /** The HashJoin plan node to be executed. */
   const HashJoinPlanNode *plan_;
+  std::unique_ptr<AbstractExecutor> left_executor_;
+  std::unique_ptr<AbstractExecutor> right_executor_;
+
+  /** Build rows, their join keys and their hashes, indexed by Entry::row_ */
+  std::vector<Tuple> build_tuples_;
+  std::vector<Value> build_keys_;
+  std::vector<Entry> build_entries_;
+  /** Build entries ordered by bucket; bucket b owns entries_[offsets_[b], offsets_[b + 1]) */
+  std::vector<Entry> entries_;
+  std::vector<uint32_t> offsets_;
+  /** hash >> bucket_shift_ is the bucket number; its top radix_bits_ bits are the partition */
+  uint32_t bucket_shift_{63};
+  uint32_t radix_bits_{0};
+  /** Bytes of the memory budget held by the rows above */
+  size_t reserved_bytes_{0};
+
+  /** Materialized left rows and their entries grouped by partition; the rest of the left child is streamed */
+  std::vector<Tuple> probe_tuples_;
+  std::vector<Entry> probe_entries_;
+  size_t probe_pos_{0};
+  bool left_drained_{false};
+
+  /** Spilled partitions not joined yet, the one being joined, and the reader over its probe rows */
+  bool spilled_{false};
+  std::vector<SpilledPartition> pending_;
+  SpilledPartition current_;
+  std::unique_ptr<TmpTupleRun::Reader> probe_reader_;
+
+  /** The left tuple being probed and the part of its bucket not scanned yet */
+  Tuple left_tuple_;
+  Value left_key_;
+  uint64_t left_hash_{0};
+  uint32_t cursor_{0};
+  uint32_t cursor_end_{0};
+  bool has_left_{false};
+  bool left_matched_{false};
 };
 
 }  // namespace bustub
@@ -42,13 +42,27 @@ class IndexScanExecutor : public AbstractExecutor {
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
  private:
+  /**
+   * Refill rids_ with the next batch of the range. The leaf latch is only held while the batch is
+   * collected, so the tuples can be modified by the parent (e.g. DELETE) without self-deadlock.
+   */
+  void FetchBatch();
+
+  /** Build an output tuple from an index entry, the columns not stored in the index are NULL. */
+  auto TupleFromEntry(const Tuple &entry) const -> Tuple;
+
   /** The index scan plan node to be executed. */
   const IndexScanPlanNode *plan_;
   const IndexInfo *index_info_;
   const TableInfo *table_info_;
-  BPlusTreeIndexForOneIntegerColumn *tree_;
-  BPlusTreeIndexIteratorForOneIntegerColumn iter_;
+  /** The part of the key range that has not been scanned yet. */
+  IndexScanRange range_;
+  bool exhausted_{false};
   std::vector<RID> rids_;
   std::vector<RID>::const_iterator rid_iter_{};
+  /** Index entries of the current batch, only collected by an index-only scan. */
+  std::vector<Tuple> entries_;
+  /** For every output column, its position in the index entry or -1 if the index does not store it. */
+  std::vector<int> entry_positions_;
 };
 }  // namespace bustub
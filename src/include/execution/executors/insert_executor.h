@@ -25,6 +25,11 @@ namespace bustub {
 /**
  * InsertExecutor executes an insert on a table.
  * Inserted values are always pulled from a child executor.
+ *
+ * The index entries of the inserted rows are handed to the indexes in batches of INDEX_BATCH_SIZE rows, so while
+ * the insert runs an index may lag the table heap by up to that many rows. Neither the child executor nor a
+ * concurrent statement (executors take no locks) finds those rows through an index before their batch is flushed,
+ * although a sequential scan already sees them. Every entry is in the indexes once Next() returns the row count.
  */
 class InsertExecutor : public AbstractExecutor {
  public:
@@ -55,11 +60,17 @@ class InsertExecutor : public AbstractExecutor {
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); };
 
  private:
+  /** Insert the buffered entries into every index of the table, one batch per index. */
+  void FlushIndexBatch();
+
   /** The insert plan node to be executed*/
   const InsertPlanNode *plan_;
   const TableInfo *table_info_;
   std::unique_ptr<AbstractExecutor> child_executor_;
   std::vector<IndexInfo *> table_indexes_;
+  /** The entries of the inserted rows not added to the indexes yet, one collection per index, and their RIDs. */
+  std::vector<std::vector<Tuple>> index_keys_;
+  std::vector<RID> index_rids_;
   bool is_end_{false};
 };
 
@@ -48,11 +48,21 @@ class NestIndexJoinExecutor : public AbstractExecutor {
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
  private:
+  /** Pull the next batch of outer tuples and look up their matches, false once the outer side is exhausted. */
+  auto ProbeBatch() -> bool;
+
   /** The nested index join plan node. */
   const NestedIndexJoinPlanNode *plan_;
   std::unique_ptr<AbstractExecutor> child_;
   const IndexInfo *index_info_;
   const TableInfo *table_info_;
-  BPlusTreeIndexForOneIntegerColumn *tree_;
+  /** Whether the key predicates cover every index key column, so each probe is a point lookup. */
+  bool full_key_;
+  /** The current batch of outer tuples and, for each of them, the RIDs of the matching inner tuples. */
+  std::vector<Tuple> left_tuples_;
+  std::vector<std::vector<RID>> left_rids_;
+  /** The outer tuple being joined and its matches that have not been emitted yet. */
+  size_t left_idx_{0};
+  std::vector<RID>::const_iterator rid_iter_{};
 };
 }  // namespace bustub
@@ -12,11 +12,13 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/seq_scan_plan.h"
+#include "storage/table/table_scan_iterator.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
@@ -50,7 +52,7 @@ class SeqScanExecutor : public AbstractExecutor {
  private:
   /** The sequential scan plan node to be executed */
   const SeqScanPlanNode *plan_;
-  TableIterator table_iter_ = {nullptr, RID(), nullptr};
+  std::unique_ptr<TableScanIterator> table_iter_;
   const TableInfo *table_info_;
 };
 }  // namespace bustub
@@ -13,18 +13,27 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/seq_scan_plan.h"
 #include "execution/plans/sort_plan.h"
+#include "execution/sort_key.h"
+#include "storage/table/tmp_tuple_run.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
 /**
  * The SortExecutor executor executes a sort.
+ *
+ * Every child tuple is buffered with its normalized sort key (SortKeyEncoder), so comparisons are byte comparisons.
+ * Tuples are buffered while the query's memory budget allows. Whenever it is used up, the buffer is sorted and
+ * spilled as a run of TmpTuplePages. If nothing was spilled the buffer is returned directly; otherwise the runs and
+ * the sorted last buffer are merged through a loser tree, which yields its first tuple as soon as every source has
+ * produced one. More than EXTERNAL_SORT_MERGE_FANOUT runs are first merged into longer runs.
  */
 class SortExecutor : public AbstractExecutor {
  public:
@@ -49,11 +58,62 @@ class SortExecutor : public AbstractExecutor {
   /** @return The output schema for the sort */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
 
+  ~SortExecutor() override { ReleaseBuffer(); }
+
  private:
+  /**
+   * Merger merges sorted sources with a loser tree: every internal node holds the source that lost the match played
+   * there, so replacing the winner's head costs one comparison per level. The sources are runs and, optionally, a
+   * sorted in-memory buffer.
+   */
+  class Merger {
+   public:
+    Merger(const SortExecutor *sort, const std::vector<std::unique_ptr<TmpTupleRun>> &runs,
+           std::vector<Tuple> *buffer, std::vector<std::string> *buffer_keys);
+
+    /** @return false once every source is exhausted */
+    auto Next(Tuple *tuple) -> bool;
+
+   private:
+    /** Load the next head of `source`, or mark it exhausted */
+    void Advance(size_t source);
+
+    /** @return whether the head of source `a` is output before the head of source `b` */
+    auto Beats(size_t a, size_t b) const -> bool;
+
+    const SortExecutor *sort_;
+    std::vector<std::unique_ptr<TmpTupleRun::Reader>> readers_;
+    std::vector<Tuple> *buffer_;
+    std::vector<std::string> *buffer_keys_;
+    size_t buffer_pos_{0};
+    std::vector<Tuple> heads_;
+    std::vector<std::string> head_keys_;
+    std::vector<bool> valid_;
+    /** tree_[0] is the winner, tree_[n] the loser at internal node n of a tree with leaves_ leaves */
+    std::vector<size_t> tree_;
+    size_t leaves_{1};
+  };
+
+  /** Order the buffered tuples and their keys by key */
+  void SortBuffer();
+
+  /** Sort the buffer, append it to a new run and empty it */
+  void SpillBuffer();
+
+  /** Drop the buffered tuples and return their memory to the budget */
+  void ReleaseBuffer();
+
   /** The sort plan node to be executed */
   const SortPlanNode *plan_;
   std::unique_ptr<AbstractExecutor> child_;
+  SortKeyEncoder encoder_;
   std::vector<Tuple> child_tuples_;
+  std::vector<std::string> keys_;
   std::vector<Tuple>::const_iterator child_iter_;
+  /** Bytes of the memory budget held by child_tuples_ and keys_ */
+  size_t reserved_bytes_{0};
+  /** Sorted runs spilled so far, and the merge over them once the input is exhausted */
+  std::vector<std::unique_ptr<TmpTupleRun>> runs_;
+  std::unique_ptr<Merger> merger_;
 };
 }  // namespace bustub
@@ -13,18 +13,22 @@
 #pragma once
 
 #include <memory>
-#include <vector>
 #include <stack>
+#include <string>
+#include <utility>
+#include <vector>
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/seq_scan_plan.h"
 #include "execution/plans/topn_plan.h"
+#include "execution/sort_key.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
 /**
- * The TopNExecutor executor executes a topn.
+ * The TopNExecutor executor executes a topn. It keeps the best N tuples in a heap ordered by their normalized sort
+ * keys (SortKeyEncoder), so every child tuple is evaluated once and compared as bytes.
  */
 class TopNExecutor : public AbstractExecutor {
  public:
@@ -34,6 +34,7 @@ namespace bustub {
 enum class PlanType {
   SeqScan,
   IndexScan,
+  BitmapHeapScan,
   Insert,
   Update,
   Delete,
@@ -0,0 +1,74 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// bitmap_heap_scan_plan.h
+//
+// Identification: src/include/execution/plans/bitmap_heap_scan_plan.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "catalog/catalog.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/index_scan_plan.h"
+
+namespace bustub {
+
+/** How the RID sets of several index scans are combined. */
+enum class BitmapCombineType { And, Or };
+
+/**
+ * BitmapHeapScanPlanNode reads the tuples matched by one or more index range scans in physical order.
+ *
+ * The children are index scans that are not executed themselves: their key ranges are used to collect
+ * RIDs, which are sorted and deduplicated, then intersected (AND) or merged (OR). The heap is read page
+ * by page, so every page holding a match is fetched once no matter how the keys are ordered. The output
+ * is in RID order, not key order.
+ */
+class BitmapHeapScanPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Creates a new bitmap heap scan plan node.
+   * @param output the output format of this scan plan node, the schema of the table
+   * @param table_oid the identifier of the table to be read
+   * @param index_scans the index scans that produce the RIDs, all on indexes of the table
+   * @param combine_type how the RIDs of several index scans are combined
+   */
+  BitmapHeapScanPlanNode(SchemaRef output, table_oid_t table_oid, std::vector<AbstractPlanNodeRef> index_scans,
+                         BitmapCombineType combine_type)
+      : AbstractPlanNode(std::move(output), std::move(index_scans)),
+        table_oid_(table_oid),
+        combine_type_(combine_type) {}
+
+  auto GetType() const -> PlanType override { return PlanType::BitmapHeapScan; }
+
+  /** @return the identifier of the table to be read */
+  auto GetTableOid() const -> table_oid_t { return table_oid_; }
+
+  /** @return the index scan producing the idx-th RID set */
+  auto GetIndexScanAt(uint32_t idx) const -> const IndexScanPlanNode & {
+    return dynamic_cast<const IndexScanPlanNode &>(*GetChildAt(idx));
+  }
+
+  /** @return how the RID sets are combined */
+  auto GetCombineType() const -> BitmapCombineType { return combine_type_; }
+
+  BUSTUB_PLAN_NODE_CLONE_WITH_CHILDREN(BitmapHeapScanPlanNode);
+
+  /** The table whose tuples are read. */
+  table_oid_t table_oid_;
+
+  /** Intersect or merge the RID sets of the index scans. */
+  BitmapCombineType combine_type_;
+
+ protected:
+  auto PlanNodeToString() const -> std::string override;
+};
+
+}  // namespace bustub
@@ -14,6 +14,7 @@
 
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "catalog/catalog.h"
 #include "execution/expressions/abstract_expression.h"
@@ -22,22 +23,57 @@
 namespace bustub {
 /**
  * IndexScanPlanNode identifies a table that should be scanned with an optional predicate.
+ *
+ * The scan may be restricted to a key range: each bound holds constant expressions for a prefix
+ * of the index key columns (empty leaves that side open), so an index on (a, b) can serve a range
+ * on a alone. A reverse scan returns keys in descending order.
+ *
+ * An index-only scan answers the query from the index entries without reading the table heap. The
+ * optimizer only marks a scan index-only when every column read above it is stored in the index;
+ * the other columns of the output are NULL.
  */
 class IndexScanPlanNode : public AbstractPlanNode {
  public:
   /**
    * Creates a new index scan plan node.
    * @param output the output format of this scan plan node
-   * @param table_oid the identifier of table to be scanned
+   * @param index_oid the identifier of the index to be scanned
+   * @param lower_bound the lowest key prefix to return, empty for an open range
+   * @param lower_inclusive whether keys equal to the lower bound are returned
+   * @param upper_bound the highest key prefix to return, empty for an open range
+   * @param upper_inclusive whether keys equal to the upper bound are returned
+   * @param reverse whether to return keys in descending order
+   * @param index_only whether to build the output from the index entries alone
    */
-  IndexScanPlanNode(SchemaRef output, index_oid_t index_oid)
-      : AbstractPlanNode(std::move(output), {}), index_oid_(index_oid) {}
+  IndexScanPlanNode(SchemaRef output, index_oid_t index_oid, std::vector<AbstractExpressionRef> lower_bound = {},
+                    bool lower_inclusive = true, std::vector<AbstractExpressionRef> upper_bound = {},
+                    bool upper_inclusive = true, bool reverse = false, bool index_only = false)
+      : AbstractPlanNode(std::move(output), {}),
+        index_oid_(index_oid),
+        lower_bound_(std::move(lower_bound)),
+        lower_inclusive_(lower_inclusive),
+        upper_bound_(std::move(upper_bound)),
+        upper_inclusive_(upper_inclusive),
+        reverse_(reverse),
+        index_only_(index_only) {}
 
   auto GetType() const -> PlanType override { return PlanType::IndexScan; }
 
   /** @return the identifier of the table that should be scanned */
   auto GetIndexOid() const -> index_oid_t { return index_oid_; }
 
+  /** @return the lower bound of the key range, empty if unbounded */
+  auto GetLowerBound() const -> const std::vector<AbstractExpressionRef> & { return lower_bound_; }
+
+  /** @return the upper bound of the key range, empty if unbounded */
+  auto GetUpperBound() const -> const std::vector<AbstractExpressionRef> & { return upper_bound_; }
+
+  /** @return true if the scan returns keys in descending order */
+  auto IsReverse() const -> bool { return reverse_; }
+
+  /** @return true if the scan does not read the table heap */
+  auto IsIndexOnly() const -> bool { return index_only_; }
+
   BUSTUB_PLAN_NODE_CLONE_WITH_CHILDREN(IndexScanPlanNode);
 
   /** The table whose tuples should be scanned. */
@@ -45,10 +81,20 @@ class IndexScanPlanNode : public AbstractPlanNode {
 
   // Add anything you want here for index lookup
 
+  /** Key range of the scan, an empty bound leaves that side open. */
+  std::vector<AbstractExpressionRef> lower_bound_;
+  bool lower_inclusive_;
+  std::vector<AbstractExpressionRef> upper_bound_;
+  bool upper_inclusive_;
+
+  /** Scan the leaves backwards, returning keys in descending order. */
+  bool reverse_;
+
+  /** Build the output from the index entries, skipping the table heap. */
+  bool index_only_;
+
  protected:
-  auto PlanNodeToString() const -> std::string override {
-    return fmt::format("IndexScan {{ index_oid={} }}", index_oid_);
-  }
+  auto PlanNodeToString() const -> std::string override;
 };
 
 }  // namespace bustub
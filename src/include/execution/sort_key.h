@@ -0,0 +1,63 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// sort_key.h
+//
+// Identification: src/include/execution/sort_key.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "binder/bound_order_by.h"
+#include "catalog/schema.h"
+#include "execution/expressions/abstract_expression.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * SortKeyEncoder turns the ORDER BY values of a tuple into one normalized key: a byte string whose memcmp order is
+ * the requested order, so the order-by expressions are evaluated once per tuple instead of once per comparison.
+ *
+ * Every order-by value becomes a NULL flag byte followed by its value bytes. Numbers are stored big-endian with
+ * the sign bit flipped, doubles with their bits ordered the same way, and strings with 0x00 escaped as 0x00 0xFF and
+ * terminated by 0x00 0x00. NULL sorts after every value, as in PostgreSQL. A DESC value has all of its bytes inverted.
+ */
+class SortKeyEncoder {
+ public:
+  SortKeyEncoder(const std::vector<std::pair<OrderByType, AbstractExpressionRef>> &order_bys, const Schema &schema);
+
+  /** @return the normalized key of `tuple` */
+  auto Encode(const Tuple &tuple) const -> std::string;
+
+ private:
+  const std::vector<std::pair<OrderByType, AbstractExpressionRef>> &order_bys_;
+  const Schema &schema_;
+};
+
+/**
+ * SortEntry is what a sort moves around: the first eight key bytes as a big-endian integer, and the row it belongs to.
+ * Most comparisons are decided by the prefix alone.
+ */
+struct SortEntry {
+  uint64_t prefix_;
+  uint32_t row_;
+};
+
+/** @return the first eight bytes of `key`, zero-padded, as a big-endian integer */
+auto SortKeyPrefix(const std::string &key) -> uint64_t;
+
+/**
+ * Sort the rows 0..keys.size() by their normalized keys.
+ * Keys of at most eight bytes are radix sorted on their prefixes; longer keys are compared as (prefix, key) pairs.
+ * @return the rows in sorted order
+ */
+auto SortByKey(const std::vector<std::string> &keys) -> std::vector<uint32_t>;
+
+}  // namespace bustub
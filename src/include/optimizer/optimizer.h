@@ -1,9 +1,11 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <tuple>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -51,7 +53,8 @@ class Optimizer {
   auto OptimizeNLJAsHashJoin(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
 
   /**
-   * @brief optimize nested loop join into index join.
+   * @brief optimize nested loop join into index join. The join predicate must be made of equalities between
+   * the outer table and a prefix of the inner index key columns.
    */
   auto OptimizeNLJAsIndexJoin(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
 
@@ -81,14 +84,66 @@ class Optimizer {
   auto IsPredicateTrue(const AbstractExpression &expr) -> bool;
 
   /**
-   * @brief optimize order by as index scan if there's an index on a table
+   * @brief optimize order by as index scan if there's an index on a table whose key starts with the order by
+   * columns. A descending order by is answered with a reverse index scan.
    */
   auto OptimizeOrderByAsIndexScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
 
+  /**
+   * @brief optimize filter + seq scan as an index range scan if the filter compares indexed columns with
+   * constants. e.g., `v1 BETWEEN 10 AND 20` only reads the leaves holding keys in [10, 20]. On a composite
+   * index the range may also fix a key prefix, e.g. `a = 1 AND b > 5` on an index (a, b, c). Terms that the
+   * range does not cover are kept in a filter above the index scan. An OR of terms that each match an index
+   * is answered by a bitmap heap scan merging the RIDs of the range scans.
+   */
+  auto OptimizeFilterAsIndexScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /**
+   * @brief turn index scans into index-only scans when every column read above the scan is stored in the index
+   * entries (key or included columns), so the table heap is never touched.
+   */
+  auto OptimizeIndexOnlyScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /** @param required_cols the columns of the plan output read by its ancestors, nullopt if all of them */
+  auto OptimizeIndexOnlyScan(const AbstractPlanNodeRef &plan,
+                             const std::optional<std::unordered_set<uint32_t>> &required_cols) -> AbstractPlanNodeRef;
+
+  /**
+   * @brief plan the index range scan answering the most terms of a conjunction over a table, see
+   * OptimizeFilterAsIndexScan for how the index is picked.
+   * @param skip_index an index that must not be used
+   * @return the index scan and the terms it does not answer (nullptr if none), nullopt if no index applies
+   */
+  auto PlanIndexRangeScan(const SchemaRef &output_schema, const TableInfo &table_info,
+                          const std::vector<AbstractExpressionRef> &conjuncts,
+                          std::optional<index_oid_t> skip_index = std::nullopt)
+      -> std::optional<std::pair<AbstractPlanNodeRef, AbstractExpressionRef>>;
+
+  /**
+   * @brief read the tuples matched by index range scans in physical order (bitmap heap scan) when the order of
+   * the rows does not matter, e.g. below an aggregation or a delete. When the terms of the filter left above
+   * the index scan match a second index, the RIDs of both scans are intersected.
+   */
+  auto OptimizeBitmapHeapScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /** @param order_matters whether the parent of the plan depends on the order of its rows */
+  auto OptimizeBitmapHeapScan(const AbstractPlanNodeRef &plan, bool order_matters) -> AbstractPlanNodeRef;
+
+  /** @brief split a predicate into its top-level AND terms */
+  auto SplitConjunction(const AbstractExpressionRef &expr) -> std::vector<AbstractExpressionRef>;
+
   /** @brief check if the index can be matched */
   auto MatchIndex(const std::string &table_name, uint32_t index_key_idx)
       -> std::optional<std::tuple<index_oid_t, std::string>>;
 
+  /**
+   * @brief match the index whose key starts with the most columns out of `col_idxs`, e.g. an index on (a, b)
+   * matches 2 columns of {b, a, c} and an index on (a, c, b) matches 1 column of {a, b}.
+   * @return the index oid and name, and the number of leading key columns matched
+   */
+  auto MatchIndexPrefix(const std::string &table_name, const std::vector<uint32_t> &col_idxs)
+      -> std::optional<std::tuple<index_oid_t, std::string, size_t>>;
+
   /**
    * @brief optimize sort + limit as top N
    */
@@ -10,8 +10,13 @@
 //===----------------------------------------------------------------------===//
 #pragma once
 
+#include <atomic>
+#include <memory>
+#include <optional>
 #include <queue>
+#include <shared_mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "concurrency/transaction.h"
@@ -32,15 +37,32 @@ namespace bustub {
  * (2) support insert & remove
  * (3) The structure should shrink and grow dynamically
  * (4) Implement index iterator for range scan
+ *
+ * In B-link mode (Lehman-Yao) every node carries a high key and a link to its right sibling.
+ * Readers hold a single read latch at a time and move right whenever a concurrent split moved
+ * their key out of the node, so they never wait for a writer higher up in the tree. Writers
+ * descend the same way, recording the path, and write-latch only the leaf; a split latches the
+ * parent afterwards, moving right along the links if it split in between. Neither takes the
+ * tree latch. Removes only delete from the leaf: nodes are never merged or freed, which keeps
+ * every link a reader may follow valid.
+ *
+ * A B-link tree may also keep its top pinned_levels levels of internal pages pinned, with child
+ * references swizzled to the cached frames, so the descent only goes through the buffer pool below
+ * those levels. A node is unpinned again once root splits push it below those levels, and at most
+ * a BLINK_PINNED_POOL_DIVISOR-th of the buffer pool is ever pinned this way.
  */
 INDEX_TEMPLATE_ARGUMENTS
 class BPlusTree {
   using InternalPage = BPlusTreeInternalPage<KeyType, page_id_t, KeyComparator>;
   using LeafPage = BPlusTreeLeafPage<KeyType, ValueType, KeyComparator>;
+  friend class IndexIterator<KeyType, ValueType, KeyComparator>;
 
  public:
   explicit BPlusTree(std::string name, BufferPoolManager *buffer_pool_manager, const KeyComparator &comparator,
-                     int leaf_max_size = LEAF_PAGE_SIZE, int internal_max_size = INTERNAL_PAGE_SIZE);
+                     int leaf_max_size = LEAF_PAGE_SIZE, int internal_max_size = INTERNAL_PAGE_SIZE,
+                     bool blink = false, int pinned_levels = 0);
+  // unpins the cached top levels of a B-link tree
+  ~BPlusTree();
   // Returns true if this B+ tree has no keys and values.
   auto IsEmpty() const -> bool;
 
@@ -53,13 +75,33 @@ class BPlusTree {
   // return the value associated with a given key
   auto GetValue(const KeyType &key, std::vector<ValueType> *result, Transaction *transaction = nullptr) -> bool;
 
+  // Insert many key-value pairs, sorted first so that the keys landing in one leaf share a descent.
+  // Returns the number of pairs inserted, the entries are left sorted. Like Insert and Remove it may be
+  // called without a transaction.
+  auto InsertBatch(std::vector<MappingType> *entries, Transaction *transaction = nullptr) -> int;
+
+  // Look up many keys with one descent per leaf, (*results)[i] receives the value of keys[i]
+  void LookupBatch(const std::vector<KeyType> &keys, std::vector<std::vector<ValueType>> *results,
+                   Transaction *transaction = nullptr);
+
   // return the page id of the root node
   auto GetRootPageId() -> page_id_t;
 
+  // shape of the tree, the counters are maintained on every change
+  auto GetHeight() const -> int { return height_; }
+  auto GetLeafCount() const -> size_t { return leaf_count_; }
+  auto GetEntryCount() const -> size_t { return entry_count_; }
+  auto GetLeafCapacity() const -> int { return leaf_max_size_ - 1; }
+  // number of successful inserts and removes so far
+  auto GetModificationCount() const -> size_t { return modification_count_; }
+
   // index iterator
   auto Begin() -> INDEXITERATOR_TYPE;
   auto Begin(const KeyType &key) -> INDEXITERATOR_TYPE;
   auto End() -> INDEXITERATOR_TYPE;
+  // range scan iterators, the iterator reports IsEnd() once it leaves the range
+  auto Begin(const IndexKeyRange<KeyType> &range) -> INDEXITERATOR_TYPE;
+  auto RBegin(const IndexKeyRange<KeyType> &range = {}) -> INDEXITERATOR_TYPE;
 
   // print the B+ tree
   void Print(BufferPoolManager *bpm);
@@ -73,6 +115,19 @@ class BPlusTree {
   void RemoveFromFile(const std::string &file_name, Transaction *transaction = nullptr);
 
  private:
+  /**
+   * An internal page in the top levels of a B-link tree, pinned once and never unpinned. Its child and
+   * right-sibling references are swizzled to the cached nodes they point to. A swizzled reference is
+   * checked against the page id stored in the page, so one that went stale after a split is refreshed.
+   * The level of a node counts up from the leaves and never changes, its depth grows with every root split.
+   */
+  struct SwizzledNode {
+    Page *page_;
+    int level_;
+    std::unique_ptr<std::atomic<SwizzledNode *>[]> children_;
+    std::atomic<SwizzledNode *> next_{nullptr};
+  };
+
   void UpdateRootPageId(int insert_record = 0);
 
   /* Debug Routines for FREE!! */
@@ -82,13 +137,26 @@ class BPlusTree {
 
   // member variable
   std::string index_name_;
-  page_id_t root_page_id_;
+  std::atomic<page_id_t> root_page_id_;
   BufferPoolManager *buffer_pool_manager_;
   KeyComparator comparator_;
   int leaf_max_size_;
   int internal_max_size_;
+  bool blink_;
+  int pinned_levels_;
   std::mutex latch_;
-  auto FindLeafPageRW(const KeyType &key, Transaction *transaction, Operation op) -> Page *;
+  std::atomic<SwizzledNode *> swizzled_root_{nullptr};
+  std::unordered_map<page_id_t, std::unique_ptr<SwizzledNode>> swizzled_nodes_;
+  std::mutex swizzle_latch_;
+  // held shared by descents that follow swizzled references, exclusively to drop cached nodes
+  std::shared_mutex unswizzle_latch_;
+  size_t max_pinned_nodes_;
+  std::atomic<int> height_{0};
+  std::atomic<size_t> leaf_count_{0};
+  std::atomic<size_t> entry_count_{0};
+  std::atomic<size_t> modification_count_{0};
+  auto FindLeafPageRW(const KeyType &key, Transaction *transaction, Operation op,
+                      std::optional<KeyType> *upper_fence = nullptr) -> Page *;
   void InsertInParentRW(Page *page_leaf, const KeyType &key, Page *page_bother, Transaction *transaction);
   void DeleteEntryRW(Page *&page, const KeyType &key, Transaction *transaction);
   void AdjustRootPageRW(Page *page, Transaction *transaction);
@@ -97,6 +165,15 @@ class BPlusTree {
                       Transaction *transaction);
   auto UnlockAndUnpin(Transaction *transaction, Operation op) -> void;
   auto IsSafe(Page *page, Operation op) -> bool;
+  auto FindEdgeLeafPage(bool leftmost) -> Page *;
+  auto FindLeafPageBLink(const KeyType *key, bool leftmost, std::vector<page_id_t> *path = nullptr,
+                         bool write = false) -> Page *;
+  auto InsertBLink(const KeyType &key, const ValueType &value) -> bool;
+  void InsertInParentBLink(Page *page, KeyType key, page_id_t right_page_id, std::vector<page_id_t> *path);
+  auto RightLinkFor(BPlusTreePage *node, const KeyType *key) const -> page_id_t;
+  auto FetchBLink(page_id_t page_id, std::atomic<SwizzledNode *> *swip, int depth, SwizzledNode **node) -> Page *;
+  auto NodeLevel(Page *page) -> int;
+  void UnswizzleBelowPinnedLevels();
 };
 
 }  // namespace bustub
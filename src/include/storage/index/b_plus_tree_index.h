@@ -27,7 +27,8 @@ namespace bustub {
 INDEX_TEMPLATE_ARGUMENTS
 class BPlusTreeIndex : public Index {
  public:
-  BPlusTreeIndex(std::unique_ptr<IndexMetadata> &&metadata, BufferPoolManager *buffer_pool_manager);
+  BPlusTreeIndex(std::unique_ptr<IndexMetadata> &&metadata, BufferPoolManager *buffer_pool_manager,
+                 bool blink = false);
 
   void InsertEntry(const Tuple &key, RID rid, Transaction *transaction) override;
 
@@ -35,20 +36,42 @@ class BPlusTreeIndex : public Index {
 
   void ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) override;
 
+  auto ScanRange(IndexScanRange *range, bool reverse, std::size_t max_results, std::vector<RID> *result,
+                 std::vector<Tuple> *entries, Transaction *transaction) -> bool override;
+
+  void InsertBatch(const std::vector<Tuple> &keys, const std::vector<RID> &rids, Transaction *transaction) override;
+
+  void LookupBatch(const std::vector<Tuple> &keys, std::vector<std::vector<RID>> *results,
+                   Transaction *transaction) override;
+
+  auto CollectStats(std::size_t histogram_buckets) -> IndexStats override;
+
+  auto GetModificationCount() const -> std::size_t override { return container_.GetModificationCount(); }
+
   auto GetBeginIterator() -> INDEXITERATOR_TYPE;
 
   auto GetBeginIterator(const KeyType &key) -> INDEXITERATOR_TYPE;
 
   auto GetEndIterator() -> INDEXITERATOR_TYPE;
 
+  auto GetBeginIterator(const IndexKeyRange<KeyType> &range) -> INDEXITERATOR_TYPE;
+
+  auto GetReverseBeginIterator(const IndexKeyRange<KeyType> &range = {}) -> INDEXITERATOR_TYPE;
+
  protected:
+  // build the key of a range bound, the columns missing from the prefix are filled with the min or max value
+  auto MakeBoundKey(const std::vector<Value> &prefix, bool fill_with_max) const -> KeyType;
+
+  // read the first `column_count` columns of the entry schema out of a stored key
+  auto KeyToValues(const KeyType &key, uint32_t column_count) const -> std::vector<Value>;
+
   // comparator for key
   KeyComparator comparator_;
   // container
   BPlusTree<KeyType, ValueType, KeyComparator> container_;
 };
 
-/** We only support index table with one integer key for now in BusTub. Hardcode everything here. */
+/** Index on a single integer column. Composite keys use the wider GenericKey instantiations. */
 
 constexpr static const auto INTEGER_SIZE = 4;
 using IntegerKeyType = GenericKey<INTEGER_SIZE>;
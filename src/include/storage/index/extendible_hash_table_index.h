@@ -39,6 +39,10 @@ class ExtendibleHashTableIndex : public Index {
 
   void ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) override;
 
+  /** Only ranges that fix every key column to one value can be answered, they are looked up all at once */
+  auto ScanRange(IndexScanRange *range, bool reverse, std::size_t max_results, std::vector<RID> *result,
+                 std::vector<Tuple> *entries, Transaction *transaction) -> bool override;
+
  protected:
   // comparator for key
   KeyComparator comparator_;
@@ -18,6 +18,8 @@
 #include <vector>
 
 #include "catalog/schema.h"
+#include "common/exception.h"
+#include "storage/index/index_stats.h"
 #include "storage/table/tuple.h"
 #include "type/value.h"
 
@@ -32,6 +34,11 @@ class Transaction;
  * index, since the external callers does not know the actual structure of
  * the index key, so it is the index's responsibility to maintain such a
  * mapping relation and does the conversion between tuple key and index key
+ *
+ * An index may also store non-key (include) columns next to the key, so that
+ * queries reading only those columns never visit the table heap. The entry
+ * schema describes what is stored per entry: the key columns followed by the
+ * include columns.
  */
 class IndexMetadata {
  public:
@@ -43,11 +50,15 @@ class IndexMetadata {
    * @param table_name The name of the table on which the index is created
    * @param tuple_schema The schema of the indexed key
    * @param key_attrs The mapping from indexed columns to base table columns
+   * @param include_attrs The base table columns stored in the index entries in addition to the key
    */
   IndexMetadata(std::string index_name, std::string table_name, const Schema *tuple_schema,
-                std::vector<uint32_t> key_attrs)
+                std::vector<uint32_t> key_attrs, const std::vector<uint32_t> &include_attrs = {})
       : name_(std::move(index_name)), table_name_(std::move(table_name)), key_attrs_(std::move(key_attrs)) {
     key_schema_ = std::make_shared<Schema>(Schema::CopySchema(tuple_schema, key_attrs_));
+    entry_attrs_ = key_attrs_;
+    entry_attrs_.insert(entry_attrs_.end(), include_attrs.begin(), include_attrs.end());
+    entry_schema_ = std::make_shared<Schema>(Schema::CopySchema(tuple_schema, entry_attrs_));
   }
 
   ~IndexMetadata() = default;
@@ -72,6 +83,12 @@ class IndexMetadata {
   /** @return The mapping relation between indexed columns and base table columns */
   inline auto GetKeyAttrs() const -> const std::vector<uint32_t> & { return key_attrs_; }
 
+  /** @return A schema object pointer that represents an index entry, the key followed by the include columns */
+  inline auto GetEntrySchema() const -> Schema * { return entry_schema_.get(); }
+
+  /** @return The mapping relation between index entry columns and base table columns */
+  inline auto GetEntryAttrs() const -> const std::vector<uint32_t> & { return entry_attrs_; }
+
   /** @return A string representation for debugging */
   auto ToString() const -> std::string {
     std::stringstream os;
@@ -94,6 +111,22 @@ class IndexMetadata {
   const std::vector<uint32_t> key_attrs_;
   /** The schema of the indexed key */
   std::shared_ptr<Schema> key_schema_;
+  /** The mapping relation between entry schema and tuple schema */
+  std::vector<uint32_t> entry_attrs_;
+  /** The schema of an index entry */
+  std::shared_ptr<Schema> entry_schema_;
+};
+
+/**
+ * Bounds of an index range scan. Each bound holds the values of a prefix of the key columns and
+ * covers every key starting with that prefix, e.g. the lower bound (5) of an index on (a, b) is
+ * the first key with a = 5. An empty bound leaves that side of the range open.
+ */
+struct IndexScanRange {
+  std::vector<Value> lower_;
+  bool lower_inclusive_{true};
+  std::vector<Value> upper_;
+  bool upper_inclusive_{true};
 };
 
 /////////////////////////////////////////////////////////////////////
@@ -139,6 +172,12 @@ class Index {
   /** @return The index key attributes */
   auto GetKeyAttrs() const -> const std::vector<uint32_t> & { return metadata_->GetKeyAttrs(); }
 
+  /** @return The index entry schema */
+  auto GetEntrySchema() const -> Schema * { return metadata_->GetEntrySchema(); }
+
+  /** @return The index entry attributes, the key attributes followed by the include attributes */
+  auto GetEntryAttrs() const -> const std::vector<uint32_t> & { return metadata_->GetEntryAttrs(); }
+
   /** @return A string representation for debugging */
   auto ToString() const -> std::string {
     std::stringstream os;
@@ -153,7 +192,7 @@ class Index {
 
   /**
    * Insert an entry into the index.
-   * @param key The index key
+   * @param key The index entry, i.e. the key followed by the include columns (see GetEntrySchema)
    * @param rid The RID associated with the key
    * @param transaction The transaction context
    */
@@ -175,6 +214,97 @@ class Index {
    */
   virtual void ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) = 0;
 
+  /**
+   * Search the index for the keys inside a range, in ascending (or descending) key order.
+   * At most `max_results` RIDs are collected per call and the range is narrowed to the part
+   * that has not been visited yet, so calling again with the same range continues the scan.
+   * @param range The key range to scan, updated to the remaining part of the range
+   * @param reverse Whether to scan in descending key order
+   * @param max_results The maximum number of RIDs to collect
+   * @param result The collection of RIDs that is populated with results of the search
+   * @param entries If not nullptr, populated with the index entry (see GetEntrySchema) of each result
+   * @param transaction The transaction context
+   * @return true if the whole range has been scanned
+   */
+  virtual auto ScanRange(IndexScanRange *range, bool reverse, std::size_t max_results, std::vector<RID> *result,
+                         std::vector<Tuple> *entries, Transaction *transaction) -> bool {
+    throw NotImplementedException("range scan is not supported by this index");
+  }
+
+  ///////////////////////////////////////////////////////////////////
+  // Batch Modification and Search
+  ///////////////////////////////////////////////////////////////////
+
+  /**
+   * Insert many entries into the index. The default inserts them one at a time, an index may
+   * sort them and share the work between keys that end up close to each other.
+   * @param keys The index entries (see GetEntrySchema)
+   * @param rids The RIDs associated with the keys, rids[i] belongs to keys[i]
+   * @param transaction The transaction context
+   */
+  virtual void InsertBatch(const std::vector<Tuple> &keys, const std::vector<RID> &rids, Transaction *transaction) {
+    for (std::size_t i = 0; i < keys.size(); i++) {
+      InsertEntry(keys[i], rids[i], transaction);
+    }
+  }
+
+  /**
+   * Search the index for many keys. The default looks them up one at a time.
+   * @param keys The index keys
+   * @param results Populated with one collection of RIDs per key, (*results)[i] for keys[i]
+   * @param transaction The transaction context
+   */
+  virtual void LookupBatch(const std::vector<Tuple> &keys, std::vector<std::vector<RID>> *results,
+                           Transaction *transaction) {
+    results->assign(keys.size(), {});
+    for (std::size_t i = 0; i < keys.size(); i++) {
+      ScanKey(keys[i], &(*results)[i], transaction);
+    }
+  }
+
+  /**
+   * Describe the shape of the index and the distribution of its leading key column.
+   * @param histogram_buckets Number of histogram buckets to sample, 0 skips the histogram and the distinct count
+   * @return The statistics, the default knows nothing about the index
+   */
+  virtual auto CollectStats(std::size_t histogram_buckets) -> IndexStats { return {}; }
+
+  /** @return The number of entries inserted or removed since the index was created */
+  virtual auto GetModificationCount() const -> std::size_t { return 0; }
+
+ protected:
+  /**
+   * Answer a range that fixes every key column to one value with ScanKey, the only range a hash index can answer.
+   * The entries of such an index hold the key columns only.
+   * @return true, the matching RIDs are all collected at once
+   */
+  auto ScanPointRange(IndexScanRange *range, std::vector<RID> *result, std::vector<Tuple> *entries,
+                      Transaction *transaction) -> bool {
+    const auto *key_schema = GetKeySchema();
+    bool is_point = range->lower_.size() == key_schema->GetColumnCount() &&
+                    range->upper_.size() == key_schema->GetColumnCount() && range->lower_inclusive_ &&
+                    range->upper_inclusive_;
+    for (uint32_t i = 0; is_point && i < key_schema->GetColumnCount(); i++) {
+      is_point = range->lower_[i].CompareEquals(range->upper_[i]) == CmpBool::CmpTrue;
+    }
+    if (!is_point) {
+      throw NotImplementedException("a hash index only answers lookups of a whole key");
+    }
+
+    std::vector<Value> values;
+    values.reserve(key_schema->GetColumnCount());
+    for (uint32_t i = 0; i < key_schema->GetColumnCount(); i++) {
+      values.push_back(range->lower_[i].CastAs(key_schema->GetColumn(i).GetType()));
+    }
+    Tuple key{values, key_schema};
+    auto found_begin = result->size();
+    ScanKey(key, result, transaction);
+    if (entries != nullptr) {
+      entries->insert(entries->end(), result->size() - found_begin, key);
+    }
+    return true;
+  }
+
  private:
   /** The Index structure owns its metadata */
   std::unique_ptr<IndexMetadata> metadata_;
@@ -13,18 +13,48 @@
  * For range scan of b+ tree
  */
 #pragma once
+#include <optional>
+
 #include "storage/page/b_plus_tree_leaf_page.h"
 
 namespace bustub {
 
 #define INDEXITERATOR_TYPE IndexIterator<KeyType, ValueType, KeyComparator>
 
+INDEX_TEMPLATE_ARGUMENTS
+class BPlusTree;
+
+/**
+ * Key bounds of a range scan. A bound that is not set leaves that side of the range open.
+ */
+template <typename KeyType>
+struct IndexKeyRange {
+  std::optional<KeyType> lower_;
+  bool lower_inclusive_{true};
+  std::optional<KeyType> upper_;
+  bool upper_inclusive_{true};
+};
+
+/**
+ * Iterator over the leaf level of a b+ tree. While it points at an entry the current leaf is
+ * pinned and read-latched; both are released once the iterator is exhausted or destroyed.
+ *
+ * A forward iterator follows next-page links, a reverse one follows prev-page links. An iterator
+ * may carry a stop key (the far bound of a range): it becomes exhausted at the first entry past it.
+ */
 INDEX_TEMPLATE_ARGUMENTS
 class IndexIterator {
  public:
   // you may define your own constructor based on your member variables
   IndexIterator();
   IndexIterator(Page *curr_page, int index, page_id_t page_id, BufferPoolManager *bufferPoolManager);
+  IndexIterator(BPlusTree<KeyType, ValueType, KeyComparator> *tree, Page *curr_page, int index,
+                BufferPoolManager *bufferPoolManager, bool reverse, std::optional<KeyType> stop_key,
+                bool stop_inclusive);
+  IndexIterator(const IndexIterator &) = delete;
+  IndexIterator(IndexIterator &&other) noexcept;
+  auto operator=(const IndexIterator &) -> IndexIterator & = delete;
+  auto operator=(IndexIterator &&other) noexcept -> IndexIterator &;
   ~IndexIterator();  // NOLINT
 
   auto IsEnd() -> bool;
@@ -42,10 +72,25 @@ class IndexIterator {
   }
 
  private:
+  /** Move to the next valid entry, hopping leaves as needed, and stop at the end of the range. */
+  void Settle();
+  /** Step to the left sibling of the current leaf, re-descending if the link went stale. */
+  void StepToPrevLeaf();
+  /** Step to the left sibling in a B-link tree, walking right from a stale prev link. */
+  void StepToPrevLeafBLink(page_id_t prev_page_id);
+  /** Release the current leaf. A bounded or reverse iterator also forgets its position. */
+  void Finish(bool hit_bound);
+
   page_id_t page_id_ = INVALID_PAGE_ID;
   Page *curr_page_ = nullptr;
   int index_ = 0;
   BufferPoolManager *buffer_pool_manager_ = nullptr;
+  BPlusTree<KeyType, ValueType, KeyComparator> *tree_ = nullptr;
+  bool reverse_ = false;
+  std::optional<KeyType> stop_key_;
+  bool stop_inclusive_ = true;
+  /** First key of the last non-empty leaf left by a reverse scan, to re-descend from an empty leaf. */
+  std::optional<KeyType> anchor_;
 };
 
 }  // namespace bustub
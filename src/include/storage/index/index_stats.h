@@ -0,0 +1,56 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// index_stats.h
+//
+// Identification: src/include/storage/index/index_stats.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * IndexStats describes the shape of an index and the distribution of its leading key column.
+ */
+struct IndexStats {
+  /** Number of levels, 0 for an empty index */
+  uint32_t height_{0};
+  /** Number of leaf pages */
+  std::size_t leaf_count_{0};
+  /** Average share of a leaf that holds entries, between 0 and 1 */
+  double avg_fill_{0};
+  /** Number of entries */
+  std::size_t entry_count_{0};
+  /** Number of distinct values of the leading key column */
+  std::size_t distinct_keys_{0};
+  /**
+   * Equi-depth histogram on the leading key column: about the same number of entries lies
+   * between two neighbouring bounds. The first bound is the smallest value, the last the largest.
+   */
+  std::vector<Value> histogram_bounds_;
+
+  /**
+   * Estimate the share of entries whose leading key column lies in [lower, upper].
+   * A missing bound leaves that side of the range open.
+   * @return a selectivity between 0 and 1, 1 when nothing is known about the distribution
+   */
+  auto EstimateSelectivity(const std::optional<Value> &lower, const std::optional<Value> &upper) const -> double;
+
+  /**
+   * @return the estimated share of entries smaller than the value: the buckets below the value plus an
+   * interpolated part of the bucket holding it, half of that bucket when the value is not numeric
+   */
+  auto FractionBelow(const Value &value) const -> double;
+};
+
+}  // namespace bustub
@@ -23,7 +23,7 @@
 
 namespace bustub {
 
-#define HASH_TABLE_INDEX_TYPE LinearProbeHashTableIndex<KeyType, ValueType, KeyComparator>
+#define LINEAR_PROBE_HASH_TABLE_INDEX_TYPE LinearProbeHashTableIndex<KeyType, ValueType, KeyComparator>
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 class LinearProbeHashTableIndex : public Index {
@@ -39,6 +39,10 @@ class LinearProbeHashTableIndex : public Index {
 
   void ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) override;
 
+  /** Only ranges that fix every key column to one value can be answered, they are looked up all at once */
+  auto ScanRange(IndexScanRange *range, bool reverse, std::size_t max_results, std::vector<RID> *result,
+                 std::vector<Tuple> *entries, Transaction *transaction) -> bool override;
+
  protected:
   // comparator for key
   KeyComparator comparator_;
@@ -17,7 +17,7 @@
 namespace bustub {
 
 #define B_PLUS_TREE_INTERNAL_PAGE_TYPE BPlusTreeInternalPage<KeyType, ValueType, KeyComparator>
-#define INTERNAL_PAGE_HEADER_SIZE 24
+#define INTERNAL_PAGE_HEADER_SIZE (32 + sizeof(KeyType))
 #define INTERNAL_PAGE_SIZE ((BUSTUB_PAGE_SIZE - INTERNAL_PAGE_HEADER_SIZE) / (sizeof(MappingType)))
 /**
  * Store n indexed keys and n+1 child pointers (page_id) within internal page.
@@ -31,6 +31,11 @@ namespace bustub {
  *  --------------------------------------------------------------------------
  * | HEADER | KEY(1)+PAGE_ID(1) | KEY(2)+PAGE_ID(2) | ... | KEY(n)+PAGE_ID(n) |
  *  --------------------------------------------------------------------------
+ *
+ * Besides the common header an internal page stores the id of its right sibling on the same
+ * level and its high key, the separator pushed up by the last split: every key of the subtree
+ * is below it. Both are maintained on splits and used by a tree in B-link mode, where a reader
+ * that lands on a node after a concurrent split follows the right link instead of waiting.
  */
 INDEX_TEMPLATE_ARGUMENTS
 class BPlusTreeInternalPage : public BPlusTreePage {
@@ -38,11 +43,16 @@ class BPlusTreeInternalPage : public BPlusTreePage {
   // must call initialize method after "create" a new node
   void Init(page_id_t page_id, page_id_t parent_id = INVALID_PAGE_ID, int max_size = INTERNAL_PAGE_SIZE);
 
+  auto GetNextPageId() const -> page_id_t;
+  auto HasHighKey() const -> bool;
+  auto GetHighKey() const -> const KeyType &;
+
   auto KeyAt(int index) const -> KeyType;
   void SetKeyAt(int index, const KeyType &key);
   auto ValueAt(int index) const -> ValueType;
 
   auto Find(const KeyType &key, const KeyComparator &keyComparator) -> ValueType;
+  auto ChildIndex(const KeyType &key, const KeyComparator &keyComparator) const -> int;
   void SetValueAt(int index, const ValueType &value);
   void Insert(const MappingType &value, const KeyComparator &keyComparator);
   void Split(const KeyType &key, Page *page_bother, Page *page_parent_page, const KeyComparator &keyComparator,
@@ -56,6 +66,9 @@ class BPlusTreeInternalPage : public BPlusTreePage {
   void Merge(const KeyType &key, Page *right_page, BufferPoolManager *buffer_pool_manager_);
 
  private:
+  page_id_t next_page_id_;
+  bool has_high_key_;
+  KeyType high_key_;
   // Flexible array member for page data.
   MappingType array_[1];
 };
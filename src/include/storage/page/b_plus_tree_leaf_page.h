@@ -18,7 +18,7 @@
 namespace bustub {
 
 #define B_PLUS_TREE_LEAF_PAGE_TYPE BPlusTreeLeafPage<KeyType, ValueType, KeyComparator>
-#define LEAF_PAGE_HEADER_SIZE 28
+#define LEAF_PAGE_HEADER_SIZE (36 + sizeof(KeyType))
 #define LEAF_PAGE_SIZE ((BUSTUB_PAGE_SIZE - LEAF_PAGE_HEADER_SIZE) / sizeof(MappingType))
 
 /**
@@ -31,13 +31,22 @@ namespace bustub {
  * | HEADER | KEY(1) + RID(1) | KEY(2) + RID(2) | ... | KEY(n) + RID(n)
  *  ----------------------------------------------------------------------
  *
- *  Header format (size in byte, 28 bytes in total):
+ *  Header format (size in byte, 36 + sizeof(KeyType) bytes in total):
  *  ---------------------------------------------------------------------
  * | PageType (4) | LSN (4) | CurrentSize (4) | MaxSize (4) |
  *  ---------------------------------------------------------------------
- *  -----------------------------------------------
- * | ParentPageId (4) | PageId (4) | NextPageId (4)
- *  -----------------------------------------------
+ *  ----------------------------------------------------------------
+ * | ParentPageId (4) | PageId (4) | NextPageId (4) | PrevPageId (4)
+ *  ----------------------------------------------------------------
+ *  ----------------------------------------------------------
+ * | HasHighKey (1) | HighKey (sizeof(KeyType)) | Padding (3) |
+ *  ----------------------------------------------------------
+ *
+ * Leaves form a doubly linked list: NextPageId is used by forward range scans
+ * and PrevPageId by reverse (descending) scans.
+ *
+ * The high key is the first key of the right sibling at the time of the last split, every key
+ * in the leaf is below it. The rightmost leaf has none. Only a tree in B-link mode relies on it.
  */
 INDEX_TEMPLATE_ARGUMENTS
 class BPlusTreeLeafPage : public BPlusTreePage {
@@ -48,6 +57,10 @@ class BPlusTreeLeafPage : public BPlusTreePage {
   // helper methods
   auto GetNextPageId() const -> page_id_t;
   void SetNextPageId(page_id_t next_page_id);
+  auto GetPrevPageId() const -> page_id_t;
+  void SetPrevPageId(page_id_t prev_page_id);
+  auto HasHighKey() const -> bool;
+  auto GetHighKey() const -> const KeyType &;
   auto KeyAt(int index) const -> KeyType;
 
   auto Remove(const KeyType &key, int index, const KeyComparator &keyComparator) -> bool;
@@ -59,10 +72,13 @@ class BPlusTreeLeafPage : public BPlusTreePage {
   void InsertFirst(const KeyType &key, const ValueType &value);
   void InsertLast(const KeyType &key, const ValueType &value);
   auto GetPair(int index) -> MappingType &;
-  void Merge(Page *right_page, BufferPoolManager *buffer_pool_manager_);
+  void Merge(Page *right_page);
 
  private:
   page_id_t next_page_id_;
+  page_id_t prev_page_id_;
+  bool has_high_key_;
+  KeyType high_key_;
   // Flexible array member for page data.
   MappingType array_[1];
 };
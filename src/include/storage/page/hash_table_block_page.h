@@ -12,7 +12,7 @@
 
 #pragma once
 
-#include <atomic>
+#include <cstdint>
 #include <utility>
 #include <vector>
 
@@ -25,13 +25,16 @@ namespace bustub {
  * Store indexed key and and value together within block page. Supports
  * non-unique keys.
  *
- * Block page format (keys are stored in order):
- *  ----------------------------------------------------------------
- * | KEY(1) + VALUE(1) | KEY(2) + VALUE(2) | ... | KEY(n) + VALUE(n)
- *  ----------------------------------------------------------------
+ * Block page format, Swiss-table style:
+ *  ---------------------------------------------------------------------------
+ * | CONTROL(1) ... CONTROL(n) | KEY(1) + VALUE(1) | ... | KEY(n) + VALUE(n)
+ *  ---------------------------------------------------------------------------
  *
  *  Here '+' means concatenation.
  *
+ * The control byte of a slot is empty, a tombstone, or the 7-bit fingerprint of the hash of the key stored in it.
+ * The slots form groups of BLOCK_GROUP_SIZE whose control bytes are compared with a fingerprint all at once, so a
+ * probe reads the 16 control bytes of a group and only the keys whose fingerprint matches.
  */
 template <typename KeyType, typename ValueType, typename KeyComparator>
 class HashTableBlockPage {
@@ -39,6 +42,16 @@ class HashTableBlockPage {
   // Delete all constructor / destructor to ensure memory safety
   HashTableBlockPage() = delete;
 
+  /** The control byte of a slot that never held a pair */
+  static constexpr int8_t EMPTY = -128;
+  /** The control byte of a slot whose pair was removed, a tombstone */
+  static constexpr int8_t DELETED = -2;
+
+  /**
+   * Marks every slot of a new block page empty.
+   */
+  void Init();
+
   /**
    * Gets the key at an index in the block.
    *
@@ -56,26 +69,22 @@ class HashTableBlockPage {
   auto ValueAt(slot_offset_t bucket_ind) const -> ValueType;
 
   /**
-   * Attempts to insert a key and value into an index in the block.
-   * The insert is thread safe. It uses compare and swap to claim the index,
-   * and then writes the key and value into the index, and then marks the
-   * index as readable.
+   * Writes a key and value into a free index in the block and sets its control byte to the fingerprint.
    *
    * @param bucket_ind index to write the key and value to
    * @param key key to insert
    * @param value value to insert
-   * @return If the value is inserted successfully, it returns true. If the
-   * index is marked as occupied before the key and value can be inserted,
-   * Insert returns false.
+   * @param fingerprint the 7-bit fingerprint of the hash of the key
    */
-  auto Insert(slot_offset_t bucket_ind, const KeyType &key, const ValueType &value) -> bool;
+  void Insert(slot_offset_t bucket_ind, const KeyType &key, const ValueType &value, uint8_t fingerprint);
 
   /**
    * Removes a key and value at index.
    *
    * @param bucket_ind ind to remove the value
+   * @param tombstone leave a tombstone if probes may pass the slot, otherwise mark it empty again
    */
-  void Remove(slot_offset_t bucket_ind);
+  void Remove(slot_offset_t bucket_ind, bool tombstone);
 
   /**
    * Returns whether or not an index is occupied (key/value pair or tombstone)
@@ -94,57 +103,27 @@ class HashTableBlockPage {
   auto IsReadable(slot_offset_t bucket_ind) const -> bool;
 
   /**
-   * Scan the bucket and collect values that have the matching key
-   *
-   * @return true if at least one key matched
-   */
-  auto GetValue(KeyType key, KeyComparator cmp, std::vector<ValueType> *result) -> bool;
-
-  /**
-   * Attempts to insert a key and value in the bucket.
-   * The insert is thread safe. It uses compare and swap to claim the index,
-   * and then writes the key and value into the index, and then marks the
-   * index as readable.
-   *
-   * @param key key to insert
-   * @param value value to insert
-   * @return true if inserted, false if duplicate KV pair or bucket is full
+   * @param group the index of a group in the block
+   * @param fingerprint the 7-bit fingerprint to look for
+   * @return a mask with bit i set if slot i of the group holds a pair with that fingerprint
    */
-  auto Insert(KeyType key, ValueType value, KeyComparator cmp) -> bool;
+  auto MatchFingerprint(size_t group, uint8_t fingerprint) const -> uint32_t;
 
   /**
-   * Removes a key and value.
-   * @return true if removed, false if not found
+   * @param group the index of a group in the block
+   * @return a mask with bit i set if slot i of the group is empty; a probe stops at a group with an empty slot
    */
-  auto Remove(KeyType key, ValueType value, KeyComparator cmp) -> bool;
+  auto MatchEmpty(size_t group) const -> uint32_t;
 
   /**
-   * @return the number of readable elements, i.e. current size
+   * @param group the index of a group in the block
+   * @return a mask with bit i set if slot i of the group is empty or a tombstone
    */
-  auto NumReadable() -> uint32_t;
-
-  /**
-   * @return whether the bucket is full
-   */
-  auto IsFull() -> bool;
-
-  /**
-   * @return whether the bucket is empty
-   */
-  auto IsEmpty() -> bool;
-
-  /**
-   * Prints the bucket's occupancy information
-   */
-  void PrintBucket();
+  auto MatchFree(size_t group) const -> uint32_t;
 
  private:
-  std::atomic_char occupied_[(BLOCK_ARRAY_SIZE - 1) / 8 + 1];
-
-  // 0 if tombstone/brand new (never occupied), 1 otherwise.
-  std::atomic_char readable_[(BLOCK_ARRAY_SIZE - 1) / 8 + 1];
-  // Flexible array member for page data.
-  MappingType array_[1];
+  int8_t control_[BLOCK_ARRAY_SIZE];
+  MappingType array_[BLOCK_ARRAY_SIZE];
 };
 
 }  // namespace bustub
@@ -31,7 +31,9 @@ namespace bustub {
  *
  *  Here '+' means concatenation.
  *  The above format omits the space required for the occupied_ and
- *  readable_ arrays. More information is in storage/page/hash_table_page_defs.h.
+ *  readable_ arrays and for the page id of the next overflow page, which
+ *  chains the pages of a bucket whose entries cannot be split apart.
+ *  More information is in storage/page/hash_table_page_defs.h.
  *
  */
 template <typename KeyType, typename ValueType, typename KeyComparator>
@@ -40,6 +42,21 @@ class HashTableBucketPage {
   // Delete all constructor / destructor to ensure memory safety
   HashTableBucketPage() = delete;
 
+  /**
+   * Init method after creating a new bucket page, clears every slot and the overflow link
+   */
+  void Init();
+
+  /**
+   * @return the page id of the next overflow page of the bucket, INVALID_PAGE_ID if there is none
+   */
+  auto GetNextPageId() const -> page_id_t;
+
+  /**
+   * @param next_page_id the page id of the next overflow page of the bucket
+   */
+  void SetNextPageId(page_id_t next_page_id);
+
   /**
    * Scan the bucket and collect values that have the matching key
    *
@@ -138,6 +155,7 @@ class HashTableBucketPage {
   void PrintBucket();
 
  private:
+  page_id_t next_page_id_;
   //  For more on BUCKET_ARRAY_SIZE see storage/page/hash_table_page_defs.h
   char occupied_[(BUCKET_ARRAY_SIZE - 1) / 8 + 1];
   // 0 if tombstone/brand new (never occupied), 1 otherwise.
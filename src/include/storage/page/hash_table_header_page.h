@@ -26,13 +26,23 @@ namespace bustub {
  *
  * Header Page for linear probing hash table.
  *
- * Header format (size in byte, 16 bytes in total):
- * -------------------------------------------------------------
- * | LSN (4) | Size (4) | PageId(4) | NextBlockIndex(4)
- * -------------------------------------------------------------
+ * Header format (size in byte, 44 bytes before the block page ids):
+ * ---------------------------------------------------------------------------------------------------------
+ * | LSN (4) | PageId(4) | Size (8) | NextBlockIndex(8) | NumEntries(8) | NumTombstones(8) | NextPageId(4) |
+ * ---------------------------------------------------------------------------------------------------------
+ *
+ * When the block page ids outgrow one header page they continue in the next header page of the chain. Size and the
+ * entry and tombstone counts are kept in the first header page of the chain.
  */
 class HashTableHeaderPage {
  public:
+  /**
+   * Initializes a new header page.
+   *
+   * @param page_id the page ID of this page
+   */
+  void Init(page_id_t page_id);
+
   /**
    * @return the number of buckets in the hash table;
    */
@@ -69,6 +79,42 @@ class HashTableHeaderPage {
    */
   void SetLSN(lsn_t lsn);
 
+  /**
+   * @return the page ID of the next header page of the chain, INVALID_PAGE_ID for the last one
+   */
+  auto GetNextPageId() const -> page_id_t;
+
+  /**
+   * Sets the page ID of the next header page of the chain
+   *
+   * @param next_page_id the page id of the next header page
+   */
+  void SetNextPageId(page_id_t next_page_id);
+
+  /**
+   * @return the number of key/value pairs in the hash table
+   */
+  auto GetNumEntries() const -> size_t;
+
+  /**
+   * Sets the number of key/value pairs in the hash table
+   *
+   * @param num_entries the number of pairs
+   */
+  void SetNumEntries(size_t num_entries);
+
+  /**
+   * @return the number of tombstones in the hash table
+   */
+  auto GetNumTombstones() const -> size_t;
+
+  /**
+   * Sets the number of tombstones in the hash table
+   *
+   * @param num_tombstones the number of tombstones
+   */
+  void SetNumTombstones(size_t num_tombstones);
+
   /**
    * Adds a block page_id to the end of header page
    *
@@ -89,13 +135,21 @@ class HashTableHeaderPage {
    */
   auto NumBlocks() -> size_t;
 
+  /**
+   * @return whether the header page holds as many block page ids as it can
+   */
+  auto IsFull() -> bool;
+
  private:
-  __attribute__((unused)) lsn_t lsn_;
-  __attribute__((unused)) size_t size_;
-  __attribute__((unused)) page_id_t page_id_;
-  __attribute__((unused)) size_t next_ind_;
+  lsn_t lsn_;
+  page_id_t page_id_;
+  size_t size_;
+  size_t next_ind_;
+  size_t num_entries_;
+  size_t num_tombstones_;
+  page_id_t next_page_id_;
   // Flexible array member for page data.
-  __attribute__((unused)) page_id_t block_page_ids_[1];
+  page_id_t block_page_ids_[1];
 };
 
 }  // namespace bustub
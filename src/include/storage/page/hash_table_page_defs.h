@@ -20,13 +20,24 @@
 #define HASH_TABLE_BLOCK_TYPE HashTableBlockPage<KeyType, ValueType, KeyComparator>
 
 /**
- * BLOCK_ARRAY_SIZE is the number of (key, value) pairs that can be stored in a linear probe hash block page. It is an
- * approximate calculation based on the size of MappingType (which is a std::pair of KeyType and ValueType). For each
- * key/value pair, we need two additional bits for occupied_ and readable_. 4 * BUSTUB_PAGE_SIZE / (4 * sizeof
- * (MappingType) + 1) = BUSTUB_PAGE_SIZE/(sizeof (MappingType) + 0.25) because 0.25 bytes = 2 bits is the space required
- * to maintain the occupied and readable flags for a key value pair.
+ * BLOCK_GROUP_SIZE is the number of slots whose control bytes a linear probe block page compares at once. The control
+ * bytes of a group are 16 consecutive bytes, which is one SSE2 register and a quarter of a cache line.
  */
-#define BLOCK_ARRAY_SIZE (4 * BUSTUB_PAGE_SIZE / (4 * sizeof(MappingType) + 1))
+#define BLOCK_GROUP_SIZE 16
+
+/**
+ * BLOCK_ARRAY_SIZE is the number of (key, value) pairs that can be stored in a linear probe hash block page. Every
+ * pair needs one control byte besides the MappingType (which is a std::pair of KeyType and ValueType), and the slots
+ * come in whole groups: BUSTUB_PAGE_SIZE / (sizeof (MappingType) + 1), rounded down to a multiple of
+ * BLOCK_GROUP_SIZE.
+ */
+#define BLOCK_ARRAY_SIZE (BUSTUB_PAGE_SIZE / (sizeof(MappingType) + 1) / BLOCK_GROUP_SIZE * BLOCK_GROUP_SIZE)
+
+/**
+ * HEADER_ARRAY_SIZE is the number of block page ids that fit in a linear probe hash header page, after its other
+ * fields, which take at most 48 bytes.
+ */
+#define HEADER_ARRAY_SIZE ((BUSTUB_PAGE_SIZE - 48) / sizeof(page_id_t))
 
 /**
  * Extendible Hashing Definitions
@@ -35,10 +46,10 @@
 
 /**
  * BUCKET_ARRAY_SIZE is the number of (key, value) pairs that can be stored in an extendible hash index bucket page.
- * The computation is the same as the above BLOCK_ARRAY_SIZE, but blocks and buckets have different implementations
- * of search, insertion, removal, and helper methods.
+ * For each key/value pair, we need two additional bits for occupied_ and readable_, so a pair takes
+ * sizeof (MappingType) + 0.25 bytes. A bucket page also keeps the page id of its overflow page.
  */
-#define BUCKET_ARRAY_SIZE (4 * BUSTUB_PAGE_SIZE / (4 * sizeof(MappingType) + 1))
+#define BUCKET_ARRAY_SIZE (4 * (BUSTUB_PAGE_SIZE - sizeof(page_id_t)) / (4 * sizeof(MappingType) + 1))
 
 /**
  * DIRECTORY_ARRAY_SIZE is the number of page_ids that can fit in the directory page of an extendible hash index.
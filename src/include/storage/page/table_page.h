@@ -123,6 +123,14 @@ class TablePage : public Page {
    */
   auto GetTuple(const RID &rid, Tuple *tuple, Transaction *txn, LockManager *lock_manager) -> bool;
 
+  /**
+   * Read a live tuple without the transaction bookkeeping of GetTuple. Meant for scans over a private copy of a page,
+   * it reuses the tuple's buffer when the sizes match.
+   * @param rid rid of the tuple to read, as returned by GetFirstTupleRid or GetNextTupleRid
+   * @param[out] tuple the tuple that was read
+   */
+  void ReadTuple(const RID &rid, Tuple *tuple);
+
   /** @return the rid of the first tuple in this page */
 
   /**
@@ -22,15 +22,53 @@ class TmpTuplePage : public Page {
  public:
   void Init(page_id_t page_id, uint32_t page_size) {
     memcpy(GetData(), &page_id, sizeof(page_id_t));
-    memcpy(GetData() + sizeof(page_id_t), &page_size, sizeof(uint32_t));
+    SetFreeSpacePointer(page_size);
   }
 
-  auto GetTablePageId() -> page_id_t { return INVALID_PAGE_ID; }
+  auto GetTablePageId() -> page_id_t { return *reinterpret_cast<page_id_t *>(GetData()); }
 
-  auto Insert(const Tuple &tuple, TmpTuple *out) -> bool { return false; }
+  /**
+   * Append a tuple to the page.
+   * @param tuple the tuple to store
+   * @param[out] out where the tuple was stored
+   * @return false if the page does not have room for the tuple
+   */
+  auto Insert(const Tuple &tuple, TmpTuple *out) -> bool {
+    uint32_t needed = sizeof(uint32_t) + tuple.GetLength();
+    uint32_t free_space_pointer = GetFreeSpacePointer();
+    if (free_space_pointer < OFFSET_TUPLES + needed) {
+      return false;
+    }
+    free_space_pointer -= needed;
+    tuple.SerializeTo(GetData() + free_space_pointer);
+    SetFreeSpacePointer(free_space_pointer);
+    *out = TmpTuple(GetTablePageId(), free_space_pointer);
+    return true;
+  }
+
+  /**
+   * Read a tuple back from the page.
+   * @param offset the offset of the tuple, as returned by Insert or NextOffset
+   * @param[out] tuple the tuple stored at that offset
+   * @return the offset of the tuple inserted just before it; the tuples end at the page size
+   */
+  auto Get(size_t offset, Tuple *tuple) -> size_t {
+    tuple->DeserializeFrom(GetData() + offset);
+    return offset + sizeof(uint32_t) + tuple->GetLength();
+  }
+
+  /** @return the offset of the most recently inserted tuple */
+  auto GetFreeSpacePointer() -> uint32_t { return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_FREE_SPACE); }
 
  private:
   static_assert(sizeof(page_id_t) == 4);
+
+  static constexpr size_t OFFSET_FREE_SPACE = sizeof(page_id_t) + sizeof(lsn_t);
+  static constexpr size_t OFFSET_TUPLES = OFFSET_FREE_SPACE + sizeof(uint32_t);
+
+  void SetFreeSpacePointer(uint32_t free_space_pointer) {
+    memcpy(GetData() + OFFSET_FREE_SPACE, &free_space_pointer, sizeof(uint32_t));
+  }
 };
 
 }  // namespace bustub
@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "buffer/buffer_pool_manager.h"
 #include "recovery/log_manager.h"
 #include "storage/page/table_page.h"
@@ -26,6 +28,7 @@ namespace bustub {
  */
 class TableHeap {
   friend class TableIterator;
+  friend class TableScanIterator;
 
  public:
   ~TableHeap() = default;
@@ -99,6 +102,17 @@ class TableHeap {
    */
   auto GetTuple(const RID &rid, Tuple *tuple, Transaction *txn, bool acquire_read_lock = true) -> bool;
 
+  /**
+   * Read several tuples stored on the same page, fetching and latching the page only once.
+   * @param begin first rid to read
+   * @param end one past the last rid to read, all rids in [begin, end) must be on the same page
+   * @param[out] tuples the tuples that exist are appended, in the order of the rids
+   * @param txn transaction performing the read
+   * @return false if the page could not be fetched
+   */
+  auto GetTuples(std::vector<RID>::const_iterator begin, std::vector<RID>::const_iterator end,
+                 std::vector<Tuple> *tuples, Transaction *txn) -> bool;
+
   /** @return the begin iterator of this table */
   auto Begin(Transaction *txn) -> TableIterator;
 
@@ -0,0 +1,54 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// table_scan_iterator.h
+//
+// Identification: src/include/storage/table/table_scan_iterator.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+
+#include "common/rid.h"
+#include "storage/page/table_page.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+class TableHeap;
+
+/**
+ * TableScanIterator reads a TableHeap a page at a time. Each page is fetched and read-latched once, copied, and
+ * released; its live tuples are then decoded from the copy. TableIterator instead fetches the page twice and copies
+ * the tuple twice for every row.
+ *
+ * The copy is what lets the scan keep no latch or pin between calls: an executor above it may write to the page being
+ * scanned (a DELETE over its own table, for one), and a latch held across Next would deadlock against it.
+ */
+class TableScanIterator {
+ public:
+  explicit TableScanIterator(TableHeap *table_heap);
+
+  /**
+   * Read the next live tuple, reusing the buffer of `tuple` when the sizes match.
+   * @return false once the whole table has been read
+   */
+  auto Next(Tuple *tuple) -> bool;
+
+ private:
+  /** Copy the page `page_id` into page_ and position rid_ on its first live tuple */
+  void LoadPage(page_id_t page_id);
+
+  TableHeap *table_heap_;
+  /** The copy of the page being read; heap-allocated since a page is 4 KB */
+  std::unique_ptr<TablePage> page_;
+  /** The next tuple of page_ to return, if has_rid_ */
+  RID rid_;
+  bool has_rid_{false};
+  page_id_t next_page_id_;
+};
+
+}  // namespace bustub
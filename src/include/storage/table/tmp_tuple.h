@@ -4,8 +4,9 @@
 
 namespace bustub {
 
-// Document this class! What does it represent?
-
+/**
+ * TmpTuple is the location of a tuple spilled to a TmpTuplePage: the page it lives on and its offset in that page.
+ */
 class TmpTuple {
  public:
   TmpTuple(page_id_t page_id, size_t offset) : page_id_(page_id), offset_(offset) {}
@@ -0,0 +1,82 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tmp_tuple_run.h
+//
+// Identification: src/include/storage/table/tmp_tuple_run.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "common/macros.h"
+#include "storage/page/tmp_tuple_page.h"
+#include "storage/table/tmp_tuple.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * TmpTupleRun is an append-only sequence of tuples spilled by an executor, stored on TmpTuplePages that live in the
+ * buffer pool. Only the page being written is pinned, so the pool evicts the rest of the run to disk as needed.
+ * The pages are deleted when the run is destroyed.
+ */
+class TmpTupleRun {
+ public:
+  explicit TmpTupleRun(BufferPoolManager *bpm) : bpm_(bpm) {}
+
+  ~TmpTupleRun();
+
+  DISALLOW_COPY_AND_MOVE(TmpTupleRun);
+
+  /**
+   * Append a tuple to the run.
+   * @return where the tuple was stored
+   * @throws Exception if the buffer pool has no frame for a new page
+   */
+  auto Append(const Tuple &tuple) -> TmpTuple;
+
+  /** Unpin the page being written. Call it before reading the run; a later Append starts a new page. */
+  void Finish();
+
+  /** @return the number of tuples in the run */
+  auto Size() const -> size_t { return num_tuples_; }
+
+  /**
+   * Reader returns the tuples of a finished run in the order they were appended, pinning one page at a time.
+   */
+  class Reader {
+   public:
+    explicit Reader(const TmpTupleRun *run) : run_(run) {}
+
+    ~Reader() { Release(); }
+
+    DISALLOW_COPY_AND_MOVE(Reader);
+
+    /** @return false once every tuple of the run has been read */
+    auto Next(Tuple *tuple) -> bool;
+
+   private:
+    void Release();
+
+    const TmpTupleRun *run_;
+    size_t page_idx_{0};
+    TmpTuplePage *page_{nullptr};
+    /** Offsets of the current page's tuples, newest first, so the next tuple to return is at the back */
+    std::vector<size_t> offsets_;
+  };
+
+ private:
+  BufferPoolManager *bpm_;
+  std::vector<page_id_t> page_ids_;
+  TmpTuplePage *write_page_{nullptr};
+  size_t num_tuples_{0};
+};
+
+}  // namespace bustub
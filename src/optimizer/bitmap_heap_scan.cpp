@@ -0,0 +1,90 @@
+#include <memory>
+#include <vector>
+
+#include "execution/plans/bitmap_heap_scan_plan.h"
+#include "execution/plans/filter_plan.h"
+#include "execution/plans/index_scan_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+namespace {
+
+/** @return true if the index scan can feed a bitmap heap scan, i.e. it reads the heap for a bounded key range */
+auto IsBitmapCandidate(const AbstractPlanNode &plan) -> bool {
+  if (plan.GetType() != PlanType::IndexScan) {
+    return false;
+  }
+  const auto &index_scan = dynamic_cast<const IndexScanPlanNode &>(plan);
+  return !index_scan.IsIndexOnly() && !index_scan.IsReverse() &&
+         (!index_scan.GetLowerBound().empty() || !index_scan.GetUpperBound().empty());
+}
+
+}  // namespace
+
+auto Optimizer::OptimizeBitmapHeapScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  // the rows of the query result are returned in the order they are produced
+  return OptimizeBitmapHeapScan(plan, true);
+}
+
+auto Optimizer::OptimizeBitmapHeapScan(const AbstractPlanNodeRef &plan, bool order_matters) -> AbstractPlanNodeRef {
+  if (plan->GetType() == PlanType::Filter) {
+    const auto &filter_plan = dynamic_cast<const FilterPlanNode &>(*plan);
+    const auto &child = filter_plan.GetChildPlan();
+
+    // The terms left above an index scan may match a second index: intersect the RIDs of both scans
+    if (!order_matters && IsBitmapCandidate(*child)) {
+      const auto &index_scan = dynamic_cast<const IndexScanPlanNode &>(*child);
+      const auto *table_info = catalog_.GetTable(catalog_.GetIndex(index_scan.GetIndexOid())->table_name_);
+      std::vector<AbstractPlanNodeRef> index_scans{child};
+      AbstractExpressionRef residual = filter_plan.GetPredicate();
+      auto other_scan = PlanIndexRangeScan(index_scan.output_schema_, *table_info,
+                                           SplitConjunction(filter_plan.GetPredicate()), index_scan.GetIndexOid());
+      if (other_scan.has_value() && IsBitmapCandidate(*other_scan->first)) {
+        index_scans.push_back(std::move(other_scan->first));
+        residual = std::move(other_scan->second);
+      }
+      AbstractPlanNodeRef bitmap_scan = std::make_shared<BitmapHeapScanPlanNode>(
+          index_scan.output_schema_, table_info->oid_, std::move(index_scans), BitmapCombineType::And);
+      if (residual == nullptr) {
+        return bitmap_scan;
+      }
+      return std::make_shared<FilterPlanNode>(filter_plan.output_schema_, std::move(residual),
+                                              std::move(bitmap_scan));
+    }
+  }
+
+  if (!order_matters && IsBitmapCandidate(*plan)) {
+    const auto &index_scan = dynamic_cast<const IndexScanPlanNode &>(*plan);
+    const auto *index_info = catalog_.GetIndex(index_scan.GetIndexOid());
+    const auto *table_info = catalog_.GetTable(index_info->table_name_);
+    return std::make_shared<BitmapHeapScanPlanNode>(index_scan.output_schema_, table_info->oid_,
+                                                    std::vector<AbstractPlanNodeRef>{plan}, BitmapCombineType::And);
+  }
+
+  // Whether the children of the plan have to keep producing rows in the same order
+  bool child_order_matters = true;
+  switch (plan->GetType()) {
+    case PlanType::Aggregation:
+    case PlanType::Delete:
+    case PlanType::Update:
+    case PlanType::Sort:
+    case PlanType::TopN:
+      child_order_matters = false;
+      break;
+    case PlanType::Filter:
+    case PlanType::Projection:
+      child_order_matters = order_matters;
+      break;
+    default:
+      break;
+  }
+
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeBitmapHeapScan(child, child_order_matters));
+  }
+  return plan->CloneWithChildren(std::move(children));
+}
+
+}  // namespace bustub
@@ -0,0 +1,301 @@
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "catalog/catalog.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/logic_expression.h"
+#include "execution/plans/bitmap_heap_scan_plan.h"
+#include "execution/plans/filter_plan.h"
+#include "execution/plans/index_scan_plan.h"
+#include "execution/plans/seq_scan_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+namespace {
+
+/** A `column <op> integer constant` term, with the column always on the left. */
+struct KeyComparison {
+  uint32_t col_idx_;
+  ComparisonType comp_type_;
+  AbstractExpressionRef constant_;
+};
+
+auto MatchKeyComparison(const AbstractExpressionRef &expr) -> std::optional<KeyComparison> {
+  const auto *comp_expr = dynamic_cast<const ComparisonExpression *>(expr.get());
+  if (comp_expr == nullptr || comp_expr->comp_type_ == ComparisonType::NotEqual) {
+    return std::nullopt;
+  }
+  auto comp_type = comp_expr->comp_type_;
+  const auto *column_expr = dynamic_cast<const ColumnValueExpression *>(comp_expr->GetChildAt(0).get());
+  auto constant = comp_expr->GetChildAt(1);
+  if (column_expr == nullptr) {
+    // `constant <op> column`, mirror the comparison
+    column_expr = dynamic_cast<const ColumnValueExpression *>(comp_expr->GetChildAt(1).get());
+    constant = comp_expr->GetChildAt(0);
+    switch (comp_type) {
+      case ComparisonType::LessThan:
+        comp_type = ComparisonType::GreaterThan;
+        break;
+      case ComparisonType::LessThanOrEqual:
+        comp_type = ComparisonType::GreaterThanOrEqual;
+        break;
+      case ComparisonType::GreaterThan:
+        comp_type = ComparisonType::LessThan;
+        break;
+      case ComparisonType::GreaterThanOrEqual:
+        comp_type = ComparisonType::LessThanOrEqual;
+        break;
+      default:
+        break;
+    }
+  }
+  const auto *constant_expr = dynamic_cast<const ConstantValueExpression *>(constant.get());
+  if (column_expr == nullptr || column_expr->GetTupleIdx() != 0 || constant_expr == nullptr ||
+      constant_expr->val_.GetTypeId() != TypeId::INTEGER || constant_expr->val_.IsNull()) {
+    return std::nullopt;
+  }
+  return KeyComparison{column_expr->GetColIdx(), comp_type, constant};
+}
+
+/** Keep the tighter of the current bound and a new one. `want_greater` is true for lower bounds. */
+void TightenBound(AbstractExpressionRef *bound, bool *inclusive, const AbstractExpressionRef &constant,
+                  bool constant_inclusive, bool want_greater) {
+  if (*bound == nullptr) {
+    *bound = constant;
+    *inclusive = constant_inclusive;
+    return;
+  }
+  const auto &curr = dynamic_cast<const ConstantValueExpression &>(**bound).val_;
+  const auto &next = dynamic_cast<const ConstantValueExpression &>(*constant).val_;
+  if (next.CompareEquals(curr) == CmpBool::CmpTrue) {
+    *inclusive = *inclusive && constant_inclusive;
+    return;
+  }
+  auto tighter = want_greater ? next.CompareGreaterThan(curr) : next.CompareLessThan(curr);
+  if (tighter == CmpBool::CmpTrue) {
+    *bound = constant;
+    *inclusive = constant_inclusive;
+  }
+}
+
+/** The tightest range on one column implied by its comparisons, nullptr for an open side. */
+struct ColumnRange {
+  AbstractExpressionRef lower_;
+  bool lower_inclusive_{true};
+  AbstractExpressionRef upper_;
+  bool upper_inclusive_{true};
+
+  /** @return true if the range holds a single value, i.e. the column is compared for equality */
+  auto IsPoint() const -> bool {
+    if (lower_ == nullptr || upper_ == nullptr || !lower_inclusive_ || !upper_inclusive_) {
+      return false;
+    }
+    const auto &lower = dynamic_cast<const ConstantValueExpression &>(*lower_).val_;
+    const auto &upper = dynamic_cast<const ConstantValueExpression &>(*upper_).val_;
+    return lower.CompareEquals(upper) == CmpBool::CmpTrue;
+  }
+
+  /** @return the share of index entries estimated to fall in the range, when the column leads the index */
+  auto EstimateSelectivity(const IndexStats &stats) const -> double {
+    auto bound_value = [](const AbstractExpressionRef &bound) -> std::optional<Value> {
+      if (bound == nullptr) {
+        return std::nullopt;
+      }
+      return dynamic_cast<const ConstantValueExpression &>(*bound).val_;
+    };
+    return stats.EstimateSelectivity(bound_value(lower_), bound_value(upper_));
+  }
+};
+
+auto SplitDisjunction(const AbstractExpressionRef &expr) -> std::vector<AbstractExpressionRef> {
+  if (const auto *logic_expr = dynamic_cast<const LogicExpression *>(expr.get());
+      logic_expr != nullptr && logic_expr->logic_type_ == LogicType::Or) {
+    auto disjuncts = SplitDisjunction(logic_expr->GetChildAt(0));
+    auto right_disjuncts = SplitDisjunction(logic_expr->GetChildAt(1));
+    disjuncts.insert(disjuncts.end(), right_disjuncts.begin(), right_disjuncts.end());
+    return disjuncts;
+  }
+  return {expr};
+}
+
+}  // namespace
+
+auto Optimizer::SplitConjunction(const AbstractExpressionRef &expr) -> std::vector<AbstractExpressionRef> {
+  if (const auto *logic_expr = dynamic_cast<const LogicExpression *>(expr.get());
+      logic_expr != nullptr && logic_expr->logic_type_ == LogicType::And) {
+    auto conjuncts = SplitConjunction(logic_expr->GetChildAt(0));
+    auto right_conjuncts = SplitConjunction(logic_expr->GetChildAt(1));
+    conjuncts.insert(conjuncts.end(), right_conjuncts.begin(), right_conjuncts.end());
+    return conjuncts;
+  }
+  return {expr};
+}
+
+auto Optimizer::OptimizeFilterAsIndexScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeFilterAsIndexScan(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() != PlanType::Filter) {
+    return optimized_plan;
+  }
+  const auto &filter_plan = dynamic_cast<const FilterPlanNode &>(*optimized_plan);
+  BUSTUB_ENSURE(filter_plan.children_.size() == 1, "Filter should have exactly one child.");
+  if (filter_plan.GetChildPlan()->GetType() != PlanType::SeqScan) {
+    return optimized_plan;
+  }
+  const auto &seq_scan = dynamic_cast<const SeqScanPlanNode &>(*filter_plan.GetChildPlan());
+  if (seq_scan.filter_predicate_ != nullptr) {
+    return optimized_plan;
+  }
+  const auto *table_info = catalog_.GetTable(seq_scan.GetTableOid());
+
+  auto index_scan =
+      PlanIndexRangeScan(seq_scan.output_schema_, *table_info, SplitConjunction(filter_plan.GetPredicate()));
+  if (!index_scan.has_value()) {
+    // An OR of terms that each match an index: merge the RIDs of all the range scans in a bitmap heap scan and
+    // recheck the whole predicate. The heap is read in RID order, the order of the sequential scan it replaces.
+    auto disjuncts = SplitDisjunction(filter_plan.GetPredicate());
+    if (disjuncts.size() == 1) {
+      return optimized_plan;
+    }
+    std::vector<AbstractPlanNodeRef> index_scans;
+    for (const auto &disjunct : disjuncts) {
+      auto disjunct_scan = PlanIndexRangeScan(seq_scan.output_schema_, *table_info, SplitConjunction(disjunct));
+      if (!disjunct_scan.has_value()) {
+        return optimized_plan;
+      }
+      index_scans.push_back(std::move(disjunct_scan->first));
+    }
+    auto bitmap_scan = std::make_shared<BitmapHeapScanPlanNode>(seq_scan.output_schema_, seq_scan.GetTableOid(),
+                                                                std::move(index_scans), BitmapCombineType::Or);
+    return std::make_shared<FilterPlanNode>(filter_plan.output_schema_, filter_plan.GetPredicate(),
+                                            std::move(bitmap_scan));
+  }
+  auto &[scan, residual] = *index_scan;
+  if (residual == nullptr) {
+    return scan;
+  }
+  return std::make_shared<FilterPlanNode>(filter_plan.output_schema_, std::move(residual), std::move(scan));
+}
+
+auto Optimizer::PlanIndexRangeScan(const SchemaRef &output_schema, const TableInfo &table_info,
+                                   const std::vector<AbstractExpressionRef> &conjuncts,
+                                   std::optional<index_oid_t> skip_index)
+    -> std::optional<std::pair<AbstractPlanNodeRef, AbstractExpressionRef>> {
+  // Tighten the range of every integer column compared with constants
+  std::unordered_map<uint32_t, ColumnRange> ranges;
+  for (const auto &conjunct : conjuncts) {
+    auto comparison = MatchKeyComparison(conjunct);
+    if (!comparison.has_value() ||
+        table_info.schema_.GetColumn(comparison->col_idx_).GetType() != TypeId::INTEGER) {
+      continue;
+    }
+    auto &range = ranges[comparison->col_idx_];
+    const auto &constant = comparison->constant_;
+    switch (comparison->comp_type_) {
+      case ComparisonType::Equal:
+        TightenBound(&range.lower_, &range.lower_inclusive_, constant, true, true);
+        TightenBound(&range.upper_, &range.upper_inclusive_, constant, true, false);
+        break;
+      case ComparisonType::GreaterThan:
+        TightenBound(&range.lower_, &range.lower_inclusive_, constant, false, true);
+        break;
+      case ComparisonType::GreaterThanOrEqual:
+        TightenBound(&range.lower_, &range.lower_inclusive_, constant, true, true);
+        break;
+      case ComparisonType::LessThan:
+        TightenBound(&range.upper_, &range.upper_inclusive_, constant, false, false);
+        break;
+      case ComparisonType::LessThanOrEqual:
+        TightenBound(&range.upper_, &range.upper_inclusive_, constant, true, false);
+        break;
+      default:
+        UNREACHABLE("not a range comparison");
+    }
+  }
+
+  // Pick the index covering the most key columns: a prefix of columns compared for equality, optionally
+  // followed by one column with a range. Among indexes covering as many columns, the one whose leading
+  // column range is estimated to match the fewest entries wins. A hash index needs every key column fixed.
+  const IndexInfo *best_index = nullptr;
+  size_t best_points = 0;
+  size_t best_columns = 0;
+  double best_selectivity = 1;
+  for (auto *index_info : catalog_.GetTableIndexes(table_info.name_)) {
+    if (skip_index.has_value() && index_info->index_oid_ == *skip_index) {
+      continue;
+    }
+    const auto &key_attrs = index_info->index_->GetKeyAttrs();
+    size_t points = 0;
+    while (points < key_attrs.size() && ranges.count(key_attrs[points]) == 1 &&
+           ranges[key_attrs[points]].IsPoint()) {
+      points++;
+    }
+    size_t columns = points < key_attrs.size() && ranges.count(key_attrs[points]) == 1 ? points + 1 : points;
+    bool is_hash = index_info->IsHash();
+    if (columns == 0 || columns < best_columns || (is_hash && points < key_attrs.size())) {
+      continue;
+    }
+    // a hash index fetches the single bucket of the key, no cheaper way to find the same rows exists
+    auto selectivity = is_hash ? 0 : ranges[key_attrs[0]].EstimateSelectivity(index_info->GetStats());
+    if (columns > best_columns || selectivity < best_selectivity) {
+      best_index = index_info;
+      best_points = points;
+      best_columns = columns;
+      best_selectivity = selectivity;
+    }
+  }
+  if (best_index == nullptr) {
+    return std::nullopt;
+  }
+
+  // The bounds share the equality prefix, the range column (if any) adds one more value to either side
+  const auto &key_attrs = best_index->index_->GetKeyAttrs();
+  std::vector<AbstractExpressionRef> lower_bound;
+  bool lower_inclusive = true;
+  std::vector<AbstractExpressionRef> upper_bound;
+  bool upper_inclusive = true;
+  for (size_t i = 0; i < best_points; i++) {
+    lower_bound.push_back(ranges[key_attrs[i]].lower_);
+    upper_bound.push_back(ranges[key_attrs[i]].upper_);
+  }
+  if (best_columns > best_points) {
+    const auto &range = ranges[key_attrs[best_points]];
+    if (range.lower_ != nullptr) {
+      lower_bound.push_back(range.lower_);
+      lower_inclusive = range.lower_inclusive_;
+    }
+    if (range.upper_ != nullptr) {
+      upper_bound.push_back(range.upper_);
+      upper_inclusive = range.upper_inclusive_;
+    }
+  }
+
+  // Comparisons on the covered columns are answered by the range, everything else stays in the filter
+  AbstractExpressionRef residual = nullptr;
+  for (const auto &conjunct : conjuncts) {
+    auto comparison = MatchKeyComparison(conjunct);
+    if (comparison.has_value() &&
+        std::find(key_attrs.begin(), key_attrs.begin() + best_columns, comparison->col_idx_) !=
+            key_attrs.begin() + best_columns) {
+      continue;
+    }
+    residual = residual == nullptr ? conjunct : std::make_shared<LogicExpression>(residual, conjunct, LogicType::And);
+  }
+
+  AbstractPlanNodeRef index_scan =
+      std::make_shared<IndexScanPlanNode>(output_schema, best_index->index_oid_, std::move(lower_bound), lower_inclusive,
+                                          std::move(upper_bound), upper_inclusive);
+  return std::make_pair(std::move(index_scan), std::move(residual));
+}
+
+}  // namespace bustub
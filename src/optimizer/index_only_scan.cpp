@@ -0,0 +1,112 @@
+#include <algorithm>
+
+#include "execution/expressions/column_value_expression.h"
+#include "execution/plans/aggregation_plan.h"
+#include "execution/plans/filter_plan.h"
+#include "execution/plans/index_scan_plan.h"
+#include "execution/plans/limit_plan.h"
+#include "execution/plans/projection_plan.h"
+#include "execution/plans/sort_plan.h"
+#include "execution/plans/topn_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+namespace {
+
+void CollectColumns(const AbstractExpressionRef &expr, std::unordered_set<uint32_t> *cols) {
+  if (const auto *column_value_expr = dynamic_cast<const ColumnValueExpression *>(expr.get());
+      column_value_expr != nullptr) {
+    cols->insert(column_value_expr->GetColIdx());
+  }
+  for (const auto &child : expr->GetChildren()) {
+    CollectColumns(child, cols);
+  }
+}
+
+}  // namespace
+
+auto Optimizer::OptimizeIndexOnlyScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  // every column of the query result is read
+  return OptimizeIndexOnlyScan(plan, std::nullopt);
+}
+
+auto Optimizer::OptimizeIndexOnlyScan(const AbstractPlanNodeRef &plan,
+                                      const std::optional<std::unordered_set<uint32_t>> &required_cols)
+    -> AbstractPlanNodeRef {
+  // The columns of the child output that are read by this node or by the nodes above it. Nodes that are not
+  // listed here may read any column of their children.
+  std::optional<std::unordered_set<uint32_t>> child_cols = std::nullopt;
+  switch (plan->GetType()) {
+    case PlanType::Projection: {
+      const auto &projection_plan = dynamic_cast<const ProjectionPlanNode &>(*plan);
+      const auto &exprs = projection_plan.GetExpressions();
+      child_cols.emplace();
+      for (uint32_t i = 0; i < exprs.size(); i++) {
+        if (!required_cols.has_value() || required_cols->count(i) > 0) {
+          CollectColumns(exprs[i], &*child_cols);
+        }
+      }
+      break;
+    }
+    case PlanType::Aggregation: {
+      const auto &agg_plan = dynamic_cast<const AggregationPlanNode &>(*plan);
+      child_cols.emplace();
+      for (const auto &expr : agg_plan.GetGroupBys()) {
+        CollectColumns(expr, &*child_cols);
+      }
+      for (const auto &expr : agg_plan.GetAggregates()) {
+        CollectColumns(expr, &*child_cols);
+      }
+      break;
+    }
+    case PlanType::Filter:
+      if (required_cols.has_value()) {
+        child_cols = required_cols;
+        CollectColumns(dynamic_cast<const FilterPlanNode &>(*plan).GetPredicate(), &*child_cols);
+      }
+      break;
+    case PlanType::Limit:
+      child_cols = required_cols;
+      break;
+    case PlanType::Sort:
+    case PlanType::TopN:
+      if (required_cols.has_value()) {
+        child_cols = required_cols;
+        const auto &order_bys = plan->GetType() == PlanType::Sort
+                                    ? dynamic_cast<const SortPlanNode &>(*plan).GetOrderBy()
+                                    : dynamic_cast<const TopNPlanNode &>(*plan).GetOrderBy();
+        for (const auto &[order_by_type, expr] : order_bys) {
+          CollectColumns(expr, &*child_cols);
+        }
+      }
+      break;
+    case PlanType::IndexScan: {
+      const auto &index_scan_plan = dynamic_cast<const IndexScanPlanNode &>(*plan);
+      if (index_scan_plan.IsIndexOnly() || !required_cols.has_value()) {
+        return plan;
+      }
+      const auto &entry_attrs = catalog_.GetIndex(index_scan_plan.GetIndexOid())->index_->GetEntryAttrs();
+      bool covered = std::all_of(required_cols->begin(), required_cols->end(), [&](uint32_t col_idx) {
+        return std::find(entry_attrs.begin(), entry_attrs.end(), col_idx) != entry_attrs.end();
+      });
+      if (!covered) {
+        return plan;
+      }
+      return std::make_shared<IndexScanPlanNode>(
+          index_scan_plan.output_schema_, index_scan_plan.GetIndexOid(), index_scan_plan.GetLowerBound(),
+          index_scan_plan.lower_inclusive_, index_scan_plan.GetUpperBound(), index_scan_plan.upper_inclusive_,
+          index_scan_plan.IsReverse(), true);
+    }
+    default:
+      break;
+  }
+
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeIndexOnlyScan(child, child_cols));
+  }
+  return plan->CloneWithChildren(std::move(children));
+}
+
+}  // namespace bustub
@@ -32,6 +32,27 @@ auto Optimizer::MatchIndex(const std::string &table_name, uint32_t index_key_idx
   return std::nullopt;
 }
 
+auto Optimizer::MatchIndexPrefix(const std::string &table_name, const std::vector<uint32_t> &col_idxs)
+    -> std::optional<std::tuple<index_oid_t, std::string, size_t>> {
+  std::optional<std::tuple<index_oid_t, std::string, size_t>> best = std::nullopt;
+  for (const auto *index_info : catalog_.GetTableIndexes(table_name)) {
+    const auto &key_attrs = index_info->index_->GetKeyAttrs();
+    size_t prefix_len = 0;
+    while (prefix_len < key_attrs.size() &&
+           std::find(col_idxs.begin(), col_idxs.end(), key_attrs[prefix_len]) != col_idxs.end()) {
+      prefix_len++;
+    }
+    // a hash index can only look up whole keys
+    if (index_info->IsHash() && prefix_len < key_attrs.size()) {
+      continue;
+    }
+    if (prefix_len > 0 && (best == std::nullopt || prefix_len > std::get<2>(*best))) {
+      best = std::make_optional(std::make_tuple(index_info->index_oid_, index_info->name_, prefix_len));
+    }
+  }
+  return best;
+}
+
 auto Optimizer::OptimizeNLJAsIndexJoin(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
   std::vector<AbstractPlanNodeRef> children;
   for (const auto &child : plan->GetChildren()) {
@@ -43,47 +64,54 @@ auto Optimizer::OptimizeNLJAsIndexJoin(const AbstractPlanNodeRef &plan) -> Abstr
     const auto &nlj_plan = dynamic_cast<const NestedLoopJoinPlanNode &>(*optimized_plan);
     // Has exactly two children
     BUSTUB_ENSURE(nlj_plan.children_.size() == 2, "NLJ should have exactly 2 children.");
-    // Check if expr is equal condition where one is for the left table, and one is for the right table.
-    if (const auto *expr = dynamic_cast<const ComparisonExpression *>(&nlj_plan.Predicate()); expr != nullptr) {
-      if (expr->comp_type_ == ComparisonType::Equal) {
-        if (const auto *left_expr = dynamic_cast<const ColumnValueExpression *>(expr->children_[0].get());
-            left_expr != nullptr) {
-          if (const auto *right_expr = dynamic_cast<const ColumnValueExpression *>(expr->children_[1].get());
-              right_expr != nullptr) {
-            // Ensure both exprs have tuple_id == 0
-            auto left_expr_tuple_0 =
-                std::make_shared<ColumnValueExpression>(0, left_expr->GetColIdx(), left_expr->GetReturnType());
-            auto right_expr_tuple_0 =
-                std::make_shared<ColumnValueExpression>(0, right_expr->GetColIdx(), right_expr->GetReturnType());
-            // Now it's in form of <column_expr> = <column_expr>. Let's match an index for them.
+    // Ensure right child is table scan
+    if (nlj_plan.GetRightPlan()->GetType() != PlanType::SeqScan) {
+      return optimized_plan;
+    }
+    const auto &right_seq_scan = dynamic_cast<const SeqScanPlanNode &>(*nlj_plan.GetRightPlan());
+
+    // Check if every term of the predicate is an equal condition where one side is for the left table, and the
+    // other is a distinct column of the right table.
+    std::vector<uint32_t> right_cols;
+    std::vector<AbstractExpressionRef> left_keys;
+    for (const auto &conjunct : SplitConjunction(nlj_plan.predicate_)) {
+      const auto *expr = dynamic_cast<const ComparisonExpression *>(conjunct.get());
+      if (expr == nullptr || expr->comp_type_ != ComparisonType::Equal) {
+        return optimized_plan;
+      }
+      const auto *left_expr = dynamic_cast<const ColumnValueExpression *>(expr->children_[0].get());
+      const auto *right_expr = dynamic_cast<const ColumnValueExpression *>(expr->children_[1].get());
+      if (left_expr == nullptr || right_expr == nullptr || left_expr->GetTupleIdx() == right_expr->GetTupleIdx()) {
+        return optimized_plan;
+      }
+      if (left_expr->GetTupleIdx() == 1) {
+        std::swap(left_expr, right_expr);
+      }
+      if (std::find(right_cols.begin(), right_cols.end(), right_expr->GetColIdx()) != right_cols.end()) {
+        return optimized_plan;
+      }
+      right_cols.push_back(right_expr->GetColIdx());
+      // Ensure the outer key has tuple_id == 0
+      left_keys.push_back(
+          std::make_shared<ColumnValueExpression>(0, left_expr->GetColIdx(), left_expr->GetReturnType()));
+    }
 
-            // Ensure right child is table scan
-            if (nlj_plan.GetRightPlan()->GetType() == PlanType::SeqScan) {
-              const auto &right_seq_scan = dynamic_cast<const SeqScanPlanNode &>(*nlj_plan.GetRightPlan());
-              if (left_expr->GetTupleIdx() == 0 && right_expr->GetTupleIdx() == 1) {
-                if (auto index = MatchIndex(right_seq_scan.table_name_, right_expr->GetColIdx());
-                    index != std::nullopt) {
-                  auto [index_oid, index_name] = *index;
-                  return std::make_shared<NestedIndexJoinPlanNode>(
-                      nlj_plan.output_schema_, nlj_plan.GetLeftPlan(), std::move(left_expr_tuple_0),
-                      right_seq_scan.GetTableOid(), index_oid, std::move(index_name), right_seq_scan.table_name_,
-                      right_seq_scan.output_schema_, nlj_plan.GetJoinType());
-                }
-              }
-              if (left_expr->GetTupleIdx() == 1 && right_expr->GetTupleIdx() == 0) {
-                if (auto index = MatchIndex(right_seq_scan.table_name_, left_expr->GetColIdx());
-                    index != std::nullopt) {
-                  auto [index_oid, index_name] = *index;
-                  return std::make_shared<NestedIndexJoinPlanNode>(
-                      nlj_plan.output_schema_, nlj_plan.GetLeftPlan(), std::move(right_expr_tuple_0),
-                      right_seq_scan.GetTableOid(), index_oid, std::move(index_name), right_seq_scan.table_name_,
-                      right_seq_scan.output_schema_, nlj_plan.GetJoinType());
-                }
-              }
-            }
-          }
-        }
+    // Now it's in form of <column_expr> = <column_expr> AND ... Let's match an index for them. The index key must
+    // start with all the right columns, otherwise some of the terms would not be checked by the index join.
+    if (auto index = MatchIndexPrefix(right_seq_scan.table_name_, right_cols);
+        index != std::nullopt && std::get<2>(*index) == right_cols.size()) {
+      auto [index_oid, index_name, prefix_len] = *index;
+      const auto &key_attrs = catalog_.GetIndex(index_oid)->index_->GetKeyAttrs();
+      std::vector<AbstractExpressionRef> key_predicates;
+      key_predicates.reserve(prefix_len);
+      for (size_t i = 0; i < prefix_len; i++) {
+        auto pos = std::find(right_cols.begin(), right_cols.end(), key_attrs[i]) - right_cols.begin();
+        key_predicates.push_back(left_keys[pos]);
       }
+      return std::make_shared<NestedIndexJoinPlanNode>(
+          nlj_plan.output_schema_, nlj_plan.GetLeftPlan(), std::move(key_predicates), right_seq_scan.GetTableOid(),
+          index_oid, std::move(index_name), right_seq_scan.table_name_, right_seq_scan.output_schema_,
+          nlj_plan.GetJoinType());
     }
   }
 
@@ -12,8 +12,11 @@ auto Optimizer::Optimize(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef
     p = OptimizeMergeProjection(p);
     p = OptimizeMergeFilterNLJ(p);
     p = OptimizeNLJAsIndexJoin(p);
+    p = OptimizeFilterAsIndexScan(p);
     p = OptimizeOrderByAsIndexScan(p);
     p = OptimizeSortLimitAsTopN(p);
+    p = OptimizeIndexOnlyScan(p);
+    p = OptimizeBitmapHeapScan(p);
     return p;
   }
   // By default, use user-defined rules.
@@ -21,6 +24,13 @@ auto Optimizer::Optimize(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef
 }
 
 auto Optimizer::EstimatedCardinality(const std::string &table_name) -> std::optional<size_t> {
+  // every row of a table has an entry in each of its indexes
+  for (auto *index_info : catalog_.GetTableIndexes(table_name)) {
+    auto stats = index_info->GetStats();
+    if (stats.height_ > 0) {
+      return std::make_optional(stats.entry_count_);
+    }
+  }
   if (StringUtil::EndsWith(table_name, "_1m")) {
     return std::make_optional(1000000);
   }
@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <memory>
+#include <vector>
 
 #include "binder/bound_order_by.h"
 #include "catalog/catalog.h"
@@ -21,6 +22,41 @@
 
 namespace bustub {
 
+namespace {
+
+/**
+ * Check if scanning an index yields the given column order. The key columns fixed to a single value by the
+ * range scan (`fixed_prefix` of them) do not affect the order, e.g. an index on (a, b) scanned with a = 1
+ * returns keys ordered by b.
+ */
+auto KeyHasOrder(const std::vector<uint32_t> &key_attrs, const std::vector<uint32_t> &order_by_columns,
+                 size_t fixed_prefix) -> bool {
+  for (size_t start = 0; start <= fixed_prefix && start + order_by_columns.size() <= key_attrs.size(); start++) {
+    if (std::equal(order_by_columns.begin(), order_by_columns.end(), key_attrs.begin() + start)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/** @return the number of leading key columns the range scan fixes to a single value */
+auto FixedPrefixLength(const IndexScanPlanNode &range_scan) -> size_t {
+  const auto &lower_bound = range_scan.GetLowerBound();
+  const auto &upper_bound = range_scan.GetUpperBound();
+  size_t len = 0;
+  while (len < lower_bound.size() && len < upper_bound.size()) {
+    const auto *lower = dynamic_cast<const ConstantValueExpression *>(lower_bound[len].get());
+    const auto *upper = dynamic_cast<const ConstantValueExpression *>(upper_bound[len].get());
+    if (lower == nullptr || upper == nullptr || lower->val_.CompareEquals(upper->val_) != CmpBool::CmpTrue) {
+      break;
+    }
+    len++;
+  }
+  return len;
+}
+
+}  // namespace
+
 auto Optimizer::OptimizeOrderByAsIndexScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
   std::vector<AbstractPlanNodeRef> children;
   for (const auto &child : plan->GetChildren()) {
@@ -32,42 +68,74 @@ auto Optimizer::OptimizeOrderByAsIndexScan(const AbstractPlanNodeRef &plan) -> A
     const auto &sort_plan = dynamic_cast<const SortPlanNode &>(*optimized_plan);
     const auto &order_bys = sort_plan.GetOrderBy();
 
-    // Has exactly one order by column
-    if (order_bys.size() != 1) {
-      return optimized_plan;
-    }
-
-    // Order type is asc or default
-    const auto &[order_type, expr] = order_bys[0];
-    if (!(order_type == OrderByType::ASC || order_type == OrderByType::DEFAULT)) {
+    // Order types are all asc (or default), or all desc
+    const auto order_type = order_bys[0].first;
+    if (order_type == OrderByType::INVALID) {
       return optimized_plan;
     }
+    bool reverse = order_type == OrderByType::DESC;
 
-    // Order expression is a column value expression
-    const auto *column_value_expr = dynamic_cast<ColumnValueExpression *>(expr.get());
-    if (column_value_expr == nullptr) {
-      return optimized_plan;
+    // Order expressions are column value expressions
+    std::vector<uint32_t> order_by_columns;
+    for (const auto &[type, expr] : order_bys) {
+      if ((type == OrderByType::DESC) != reverse || type == OrderByType::INVALID) {
+        return optimized_plan;
+      }
+      const auto *column_value_expr = dynamic_cast<ColumnValueExpression *>(expr.get());
+      if (column_value_expr == nullptr) {
+        return optimized_plan;
+      }
+      order_by_columns.push_back(column_value_expr->GetColIdx());
     }
 
-    auto order_by_column_id = column_value_expr->GetColIdx();
-
     // Has exactly one child
     BUSTUB_ENSURE(optimized_plan->children_.size() == 1, "Sort with multiple children?? Impossible!");
     const auto &child_plan = optimized_plan->children_[0];
 
-    if (child_plan->GetType() == PlanType::SeqScan) {
-      const auto &seq_scan = dynamic_cast<const SeqScanPlanNode &>(*child_plan);
+    // A filter keeps the order of its input, look through it
+    const FilterPlanNode *filter_plan = nullptr;
+    const AbstractPlanNode *scan_plan = child_plan.get();
+    if (child_plan->GetType() == PlanType::Filter) {
+      filter_plan = dynamic_cast<const FilterPlanNode *>(child_plan.get());
+      scan_plan = filter_plan->GetChildPlan().get();
+    }
+
+    AbstractPlanNodeRef index_scan = nullptr;
+    if (scan_plan->GetType() == PlanType::SeqScan) {
+      const auto &seq_scan = dynamic_cast<const SeqScanPlanNode &>(*scan_plan);
       const auto *table_info = catalog_.GetTable(seq_scan.GetTableOid());
       const auto indices = catalog_.GetTableIndexes(table_info->name_);
 
       for (const auto *index : indices) {
-        const auto &columns = index->key_schema_.GetColumns();
-        if (columns.size() == 1 &&
-            columns[0].GetName() == table_info->schema_.GetColumn(order_by_column_id).GetName()) {
+        // the entries of a hash index are not kept in key order
+        if (index->IsHash()) {
+          continue;
+        }
+        if (KeyHasOrder(index->index_->GetKeyAttrs(), order_by_columns, 0)) {
           // Index matched, return index scan instead
-          return std::make_shared<IndexScanPlanNode>(optimized_plan->output_schema_, index->index_oid_);
+          index_scan = std::make_shared<IndexScanPlanNode>(seq_scan.output_schema_, index->index_oid_,
+                                                           std::vector<AbstractExpressionRef>{}, true,
+                                                           std::vector<AbstractExpressionRef>{}, true, reverse);
+          break;
         }
       }
+    } else if (scan_plan->GetType() == PlanType::IndexScan) {
+      // A range scan produced from a filter, only the direction has to be set
+      const auto &range_scan = dynamic_cast<const IndexScanPlanNode &>(*scan_plan);
+      const auto *index = catalog_.GetIndex(range_scan.GetIndexOid());
+      if (KeyHasOrder(index->index_->GetKeyAttrs(), order_by_columns, FixedPrefixLength(range_scan))) {
+        index_scan = std::make_shared<IndexScanPlanNode>(range_scan.output_schema_, range_scan.index_oid_,
+                                                         range_scan.lower_bound_, range_scan.lower_inclusive_,
+                                                         range_scan.upper_bound_, range_scan.upper_inclusive_, reverse);
+      }
+    }
+
+    if (index_scan != nullptr) {
+      if (filter_plan != nullptr) {
+        return std::make_shared<FilterPlanNode>(filter_plan->output_schema_, filter_plan->GetPredicate(),
+                                                std::move(index_scan));
+      }
+      return index_scan;
     }
   }
 
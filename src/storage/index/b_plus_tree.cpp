@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <numeric>
 #include <string>
 
 #include "common/exception.h"
@@ -9,13 +11,23 @@
 namespace bustub {
 INDEX_TEMPLATE_ARGUMENTS
 BPLUSTREE_TYPE::BPlusTree(std::string name, BufferPoolManager *buffer_pool_manager, const KeyComparator &comparator,
-                          int leaf_max_size, int internal_max_size)
+                          int leaf_max_size, int internal_max_size, bool blink, int pinned_levels)
     : index_name_(std::move(name)),
       root_page_id_(INVALID_PAGE_ID),
       buffer_pool_manager_(buffer_pool_manager),
       comparator_(comparator),
       leaf_max_size_(leaf_max_size),
-      internal_max_size_(internal_max_size) {}
+      internal_max_size_(internal_max_size),
+      blink_(blink),
+      pinned_levels_(blink ? pinned_levels : 0),
+      max_pinned_nodes_(pinned_levels_ > 0 ? buffer_pool_manager->GetPoolSize() / BLINK_PINNED_POOL_DIVISOR : 0) {}
+
+INDEX_TEMPLATE_ARGUMENTS
+BPLUSTREE_TYPE::~BPlusTree() {
+  for (const auto &[page_id, node] : swizzled_nodes_) {
+    buffer_pool_manager_->UnpinPage(page_id, false);
+  }
+}
 
 /*
  * Helper function to decide whether current b+tree is empty
@@ -56,11 +68,72 @@ auto BPLUSTREE_TYPE::GetValue(const KeyType &key, std::vector<ValueType> *result
   return find;
 }
 
+/*
+ * Look up many keys. The keys are visited in sorted order, and all the keys below the upper
+ * fence of a leaf are answered from it while it stays latched, one descent per leaf.
+ */
 INDEX_TEMPLATE_ARGUMENTS
-auto BPLUSTREE_TYPE::FindLeafPageRW(const KeyType &key, Transaction *transaction, Operation op) -> Page * {
+void BPLUSTREE_TYPE::LookupBatch(const std::vector<KeyType> &keys, std::vector<std::vector<ValueType>> *results,
+                                 Transaction *transaction) {
+  results->assign(keys.size(), {});
+  std::vector<size_t> order(keys.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+            [this, &keys](size_t lhs, size_t rhs) { return comparator_(keys[lhs], keys[rhs]) < 0; });
+  size_t i = 0;
+  while (i < order.size()) {
+    std::optional<KeyType> upper_fence;
+    auto page = FindLeafPageRW(keys[order[i]], transaction, READ, &upper_fence);
+    if (page == nullptr) {
+      return;
+    }
+    auto leaf_page = reinterpret_cast<LeafPage *>(page->GetData());
+    do {
+      const KeyType &key = keys[order[i]];
+      int index = leaf_page->KeyIndex(key, comparator_);
+      if (index < leaf_page->GetSize() && comparator_(leaf_page->KeyAt(index), key) == 0) {
+        (*results)[order[i]].push_back(leaf_page->ValueAt(index));
+      }
+      i++;
+    } while (i < order.size() && (!upper_fence.has_value() || comparator_(keys[order[i]], *upper_fence) < 0));
+    if (transaction == nullptr) {
+      page->RUnlatch();
+      buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+    } else {
+      UnlockAndUnpin(transaction, READ);
+    }
+  }
+}
+
+/*
+ * Find the leaf page the key belongs to, latched for the operation. If upper_fence is given it
+ * receives the smallest key that belongs to a leaf further right, so that the caller can tell
+ * whether other keys fall into the same leaf while holding its latch (none for the last leaf).
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::FindLeafPageRW(const KeyType &key, Transaction *transaction, Operation op,
+                                    std::optional<KeyType> *upper_fence) -> Page * {
   if (IsEmpty()) {
     return nullptr;
   }
+  if (upper_fence != nullptr) {
+    upper_fence->reset();
+  }
+  if (blink_) {
+    // B-link 模式下写者同样无需树锁与祖先的锁，只对叶子加写锁
+    Page *leaf_page = FindLeafPageBLink(&key, true, nullptr, op != Operation::READ);
+    if (leaf_page == nullptr) {
+      return nullptr;
+    }
+    auto leaf_node = reinterpret_cast<LeafPage *>(leaf_page->GetData());
+    if (upper_fence != nullptr && leaf_node->HasHighKey()) {
+      *upper_fence = leaf_node->GetHighKey();
+    }
+    if (transaction != nullptr) {
+      transaction->AddIntoPageSet(leaf_page);
+    }
+    return leaf_page;
+  }
   latch_.lock();
   // 获取根节点所在页
   Page *curr_page = buffer_pool_manager_->FetchPage(root_page_id_);
@@ -96,7 +169,12 @@ auto BPLUSTREE_TYPE::FindLeafPageRW(const KeyType &key, Transaction *transaction
   auto curr_page_inter = reinterpret_cast<InternalPage *>(curr_page->GetData());
   // 找到叶子节点所在页
   while (!curr_page_inter->IsLeafPage()) {
-    Page *next_page = buffer_pool_manager_->FetchPage(curr_page_inter->Find(key, comparator_));
+    int slot = curr_page_inter->ChildIndex(key, comparator_);
+    // 子树的上界是右侧的分隔 key；最右的孩子沿用上一层的上界
+    if (upper_fence != nullptr && slot + 1 < curr_page_inter->GetSize()) {
+      *upper_fence = curr_page_inter->KeyAt(slot + 1);
+    }
+    Page *next_page = buffer_pool_manager_->FetchPage(curr_page_inter->ValueAt(slot));
     if (op == Operation::READ) {
       next_page->RLatch();
       if (transaction != nullptr) {
@@ -133,6 +211,197 @@ auto BPLUSTREE_TYPE::IsSafe(Page *page, Operation op) -> bool {
   return node->GetSize() > node->GetMinSize();
 }
 
+/*
+ * Descent of a tree in B-link mode. Only one latch is held at a time: a node is released
+ * before its child or right sibling is latched. If the key is not below the high key of a node,
+ * a split moved it to the right after the parent was read, so follow the right link. Nodes are
+ * never freed in B-link mode, thus a page id read from a released node is always safe to fetch.
+ * A null key descends along the leftmost or rightmost edge instead.
+ * If path is given it receives the internal nodes the descent went down from, root first, so
+ * that a writer can find the parents of the nodes it splits.
+ * @return : the pinned leaf page, write-latched if write is set and read-latched otherwise
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::FindLeafPageBLink(const KeyType *key, bool leftmost, std::vector<page_id_t> *path, bool write)
+    -> Page * {
+  // 持有共享锁期间，缓存的节点不会被丢弃
+  std::shared_lock<std::shared_mutex> guard(unswizzle_latch_, std::defer_lock);
+  if (pinned_levels_ > 0) {
+    guard.lock();
+  }
+  int depth = 0;
+  SwizzledNode *swizzled = nullptr;
+  Page *curr_page = FetchBLink(root_page_id_, &swizzled_root_, depth, &swizzled);
+  while (curr_page != nullptr) {
+    auto node = reinterpret_cast<BPlusTreePage *>(curr_page->GetData());
+    // 页类型在初始化后不会改变，加锁前即可判断；写者只对叶子加写锁
+    bool write_latch = write && node->IsLeafPage();
+    if (write_latch) {
+      curr_page->WLatch();
+    } else {
+      curr_page->RLatch();
+    }
+    // 分裂总是把后半截移到右兄弟，因此沿左边缘下降时无需右移
+    page_id_t next_page_id = key == nullptr && leftmost ? INVALID_PAGE_ID : RightLinkFor(node, key);
+    std::atomic<SwizzledNode *> *swip = nullptr;
+    if (next_page_id != INVALID_PAGE_ID) {
+      swip = swizzled == nullptr ? nullptr : &swizzled->next_;
+    } else {
+      if (node->IsLeafPage()) {
+        return curr_page;
+      }
+      auto inter_node = reinterpret_cast<InternalPage *>(node);
+      int slot;
+      if (key != nullptr) {
+        slot = inter_node->ChildIndex(*key, comparator_);
+      } else {
+        slot = leftmost ? 0 : inter_node->GetSize() - 1;
+      }
+      next_page_id = inter_node->ValueAt(slot);
+      swip = swizzled == nullptr ? nullptr : &swizzled->children_[slot];
+      if (path != nullptr) {
+        path->push_back(curr_page->GetPageId());
+      }
+      depth++;
+    }
+    if (write_latch) {
+      curr_page->WUnlatch();
+    } else {
+      curr_page->RUnlatch();
+    }
+    // 被缓存的上层页始终保持 pin，不需要 unpin
+    if (swizzled == nullptr) {
+      buffer_pool_manager_->UnpinPage(curr_page->GetPageId(), false);
+    }
+    curr_page = FetchBLink(next_page_id, swip, depth, &swizzled);
+  }
+  return nullptr;
+}
+
+/*
+ * Fetch a page on the B-link descent. An internal page within the top pinned_levels_ levels is
+ * pinned and cached as a swizzled node: a valid swizzled reference resolves to the frame without
+ * a buffer pool lookup, a stale or missing one is refreshed. depth is the distance from the root
+ * the descent started at, the level of a page is only checked when it is first cached. *node is
+ * set for a cached page, which must not be unpinned; any other page is fetched (and pinned) as usual.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::FetchBLink(page_id_t page_id, std::atomic<SwizzledNode *> *swip, int depth,
+                                SwizzledNode **node) -> Page * {
+  *node = nullptr;
+  if (swip != nullptr) {
+    // 缓存的页一直 pin 住，其所在的帧不会被替换，可以直接比较 page id
+    SwizzledNode *cached = swip->load();
+    if (cached != nullptr && cached->page_->GetPageId() == page_id) {
+      *node = cached;
+      return cached->page_;
+    }
+  }
+  Page *page = buffer_pool_manager_->FetchPage(page_id);
+  // 页类型在初始化后不会改变，无需加锁即可读取
+  if (page == nullptr || depth >= pinned_levels_ || reinterpret_cast<BPlusTreePage *>(page->GetData())->IsLeafPage()) {
+    return page;
+  }
+  std::lock_guard<std::mutex> guard(swizzle_latch_);
+  auto iter = swizzled_nodes_.find(page_id);
+  if (iter == swizzled_nodes_.end()) {
+    if (swizzled_nodes_.size() >= max_pinned_nodes_) {
+      return page;
+    }
+    // 下降开始后根可能又分裂了，按层数确认该页仍在顶部 pinned_levels_ 层之内
+    int level = NodeLevel(page);
+    if (level < height_ - pinned_levels_) {
+      return page;
+    }
+    // 本次 fetch 的 pin 交给缓存，直到该页落到缓存的层之下或树被析构
+    auto swizzled = std::make_unique<SwizzledNode>();
+    swizzled->page_ = page;
+    swizzled->level_ = level;
+    swizzled->children_ = std::make_unique<std::atomic<SwizzledNode *>[]>(internal_max_size_ + 1);
+    iter = swizzled_nodes_.emplace(page_id, std::move(swizzled)).first;
+  } else {
+    buffer_pool_manager_->UnpinPage(page_id, false);
+  }
+  if (swip != nullptr) {
+    swip->store(iter->second.get());
+  }
+  *node = iter->second.get();
+  return page;
+}
+
+/*
+ * @return : the level of an internal page counted up from the leaves, found by following the
+ * leftmost children down (a split keeps the first child of a node), -1 if the pool is exhausted
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::NodeLevel(Page *page) -> int {
+  int level = 0;
+  page_id_t page_id = INVALID_PAGE_ID;
+  while (!reinterpret_cast<BPlusTreePage *>(page->GetData())->IsLeafPage()) {
+    page->RLatch();
+    page_id_t child_page_id = reinterpret_cast<InternalPage *>(page->GetData())->ValueAt(0);
+    page->RUnlatch();
+    if (page_id != INVALID_PAGE_ID) {
+      buffer_pool_manager_->UnpinPage(page_id, false);
+    }
+    page = buffer_pool_manager_->FetchPage(child_page_id);
+    if (page == nullptr) {
+      return -1;
+    }
+    page_id = child_page_id;
+    level++;
+  }
+  if (page_id != INVALID_PAGE_ID) {
+    buffer_pool_manager_->UnpinPage(page_id, false);
+  }
+  return level;
+}
+
+/*
+ * After a root split every cached node is one level deeper: unpin and drop those below the top
+ * pinned_levels_ levels. All swizzled references are cleared, since some may point at dropped
+ * nodes, and are swizzled again by the following descents. Waits for the running descents.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::UnswizzleBelowPinnedLevels() {
+  std::unique_lock<std::shared_mutex> guard(unswizzle_latch_);
+  std::lock_guard<std::mutex> map_guard(swizzle_latch_);
+  int min_level = height_ - pinned_levels_;
+  swizzled_root_ = nullptr;
+  for (auto iter = swizzled_nodes_.begin(); iter != swizzled_nodes_.end();) {
+    if (iter->second->level_ < min_level) {
+      buffer_pool_manager_->UnpinPage(iter->first, false);
+      iter = swizzled_nodes_.erase(iter);
+      continue;
+    }
+    for (int i = 0; i <= internal_max_size_; i++) {
+      iter->second->children_[i] = nullptr;
+    }
+    iter->second->next_ = nullptr;
+    ++iter;
+  }
+}
+
+/*
+ * @return : the right sibling of the node if the key is not below its high key (any key if
+ * the key is null), INVALID_PAGE_ID if the key belongs to this node
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::RightLinkFor(BPlusTreePage *node, const KeyType *key) const -> page_id_t {
+  if (node->IsLeafPage()) {
+    auto leaf_node = reinterpret_cast<LeafPage *>(node);
+    if (leaf_node->HasHighKey() && (key == nullptr || comparator_(*key, leaf_node->GetHighKey()) >= 0)) {
+      return leaf_node->GetNextPageId();
+    }
+    return INVALID_PAGE_ID;
+  }
+  auto inter_node = reinterpret_cast<InternalPage *>(node);
+  if (inter_node->HasHighKey() && (key == nullptr || comparator_(*key, inter_node->GetHighKey()) >= 0)) {
+    return inter_node->GetNextPageId();
+  }
+  return INVALID_PAGE_ID;
+}
+
 INDEX_TEMPLATE_ARGUMENTS
 auto BPLUSTREE_TYPE::UnlockAndUnpin(Transaction *transaction, Operation op) -> void {
   if (transaction == nullptr) {
@@ -165,6 +434,14 @@ auto BPLUSTREE_TYPE::UnlockAndUnpin(Transaction *transaction, Operation op) -> v
  */
 INDEX_TEMPLATE_ARGUMENTS
 auto BPLUSTREE_TYPE::Insert(const KeyType &key, const ValueType &value, Transaction *transaction) -> bool {
+  if (blink_) {
+    return InsertBLink(key, value);
+  }
+  // 加锁下降用 transaction 记录持有的页，调用者没有提供时使用一个临时的
+  Transaction local_transaction(INVALID_TXN_ID);
+  if (transaction == nullptr) {
+    transaction = &local_transaction;
+  }
   // 找到对应叶子节点
   Page *page_leaf = FindLeafPageRW(key, transaction, INSERT);
   // case: 现有树为空，新建树
@@ -176,6 +453,8 @@ auto BPLUSTREE_TYPE::Insert(const KeyType &key, const ValueType &value, Transact
       auto leaf_node = reinterpret_cast<LeafPage *>(page->GetData());
       leaf_node->Init(page_id, INVALID_PAGE_ID, leaf_max_size_);
       root_page_id_ = page_id;
+      height_ = 1;
+      leaf_count_++;
       UpdateRootPageId(true);
       buffer_pool_manager_->UnpinPage(page_id, true);
     }
@@ -189,6 +468,8 @@ auto BPLUSTREE_TYPE::Insert(const KeyType &key, const ValueType &value, Transact
     UnlockAndUnpin(transaction, INSERT);
     return false;
   }
+  entry_count_++;
+  modification_count_++;
   // 叶子页插入一项后，大小为 max_size，那么需要分裂
   if (leaf_node->GetSize() == leaf_max_size_) {
     page_id_t page_bother_id;
@@ -197,6 +478,15 @@ auto BPLUSTREE_TYPE::Insert(const KeyType &key, const ValueType &value, Transact
     leaf_bother_node->Init(page_bother_id, INVALID_PAGE_ID, leaf_max_size_);
     // 分裂，page_bother 为后半截
     leaf_node->Split(page_bother);
+    leaf_count_++;
+    // 原右邻居的 prev 需要指向 page_bother（从左到右加锁，与正向迭代器一致）
+    if (leaf_bother_node->GetNextPageId() != INVALID_PAGE_ID) {
+      Page *page_next = buffer_pool_manager_->FetchPage(leaf_bother_node->GetNextPageId());
+      page_next->WLatch();
+      reinterpret_cast<LeafPage *>(page_next->GetData())->SetPrevPageId(page_bother_id);
+      page_next->WUnlatch();
+      buffer_pool_manager_->UnpinPage(page_next->GetPageId(), true);
+    }
     // 父页需要插入一项，key = leaf_bother_node->KeyAt(0)，value = page_bother->GetPageId()
     InsertInParentRW(page_leaf, leaf_bother_node->KeyAt(0), page_bother, transaction);
   }
@@ -204,6 +494,202 @@ auto BPLUSTREE_TYPE::Insert(const KeyType &key, const ValueType &value, Transact
   return true;
 }
 
+/*
+ * Insert in B-link mode (Lehman-Yao). The descent read-latches one node at a time and records
+ * the internal nodes it went down from, then write-latches the leaf only, moving right if a split
+ * moved the key away. A full leaf is split and the separator is posted to the parent afterwards.
+ * The tree latch is never taken: the first root is published with a compare-and-swap.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::InsertBLink(const KeyType &key, const ValueType &value) -> bool {
+  while (IsEmpty()) {
+    // 新根在发布前就持有写锁，任何写者都要等到 header 记录插入之后才能分裂它
+    page_id_t page_id;
+    Page *page = buffer_pool_manager_->NewPage(&page_id);
+    page->WLatch();
+    reinterpret_cast<LeafPage *>(page->GetData())->Init(page_id, INVALID_PAGE_ID, leaf_max_size_);
+    page_id_t expected = INVALID_PAGE_ID;
+    bool published = root_page_id_.compare_exchange_strong(expected, page_id);
+    if (published) {
+      height_ = 1;
+      leaf_count_++;
+      UpdateRootPageId(true);
+    }
+    page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(page_id, published);
+    if (!published) {
+      buffer_pool_manager_->DeletePage(page_id);
+    }
+  }
+  std::vector<page_id_t> path;
+  Page *page_leaf = FindLeafPageBLink(&key, true, &path, true);
+  auto leaf_node = reinterpret_cast<LeafPage *>(page_leaf->GetData());
+  int index = leaf_node->KeyIndex(key, comparator_);
+  if (!leaf_node->Insert(std::make_pair(key, value), index, comparator_)) {
+    page_leaf->WUnlatch();
+    buffer_pool_manager_->UnpinPage(page_leaf->GetPageId(), false);
+    return false;
+  }
+  entry_count_++;
+  modification_count_++;
+  if (leaf_node->GetSize() < leaf_max_size_) {
+    page_leaf->WUnlatch();
+    buffer_pool_manager_->UnpinPage(page_leaf->GetPageId(), true);
+    return true;
+  }
+  // 分裂：bother 的内容在叶子的 next 指向它之前已经写好，叶子释放前其他线程看不到它
+  page_id_t page_bother_id;
+  Page *page_bother = buffer_pool_manager_->NewPage(&page_bother_id);
+  auto leaf_bother_node = reinterpret_cast<LeafPage *>(page_bother->GetData());
+  leaf_bother_node->Init(page_bother_id, INVALID_PAGE_ID, leaf_max_size_);
+  leaf_node->Split(page_bother);
+  leaf_count_++;
+  if (leaf_bother_node->GetNextPageId() != INVALID_PAGE_ID) {
+    Page *page_next = buffer_pool_manager_->FetchPage(leaf_bother_node->GetNextPageId());
+    page_next->WLatch();
+    reinterpret_cast<LeafPage *>(page_next->GetData())->SetPrevPageId(page_bother_id);
+    page_next->WUnlatch();
+    buffer_pool_manager_->UnpinPage(page_next->GetPageId(), true);
+  }
+  KeyType separator = leaf_bother_node->KeyAt(0);
+  buffer_pool_manager_->UnpinPage(page_bother_id, true);
+  InsertInParentBLink(page_leaf, separator, page_bother_id, &path);
+  return true;
+}
+
+/*
+ * Post the separator of a split in B-link mode. page is the write-latched node that was split,
+ * right_page_id its new right sibling, already reachable through the right link. The node is
+ * released before its parent is latched, so a writer holds at most two latches on one level
+ * while moving right and never waits for a node below one it holds. The parent is taken from
+ * the recorded path and moved right from if it split meanwhile; if the path is used up although
+ * the node is no longer the root, the root split since the descent and the path is read again.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::InsertInParentBLink(Page *page, KeyType key, page_id_t right_page_id,
+                                         std::vector<page_id_t> *path) {
+  size_t level = 0;
+  while (true) {
+    page_id_t page_id = page->GetPageId();
+    // 仍持有旧根的写锁，根的分裂因此是互斥的
+    if (page_id == root_page_id_) {
+      page_id_t new_page_id;
+      Page *new_page = buffer_pool_manager_->NewPage(&new_page_id);
+      auto new_root = reinterpret_cast<InternalPage *>(new_page->GetData());
+      new_root->Init(new_page_id, INVALID_PAGE_ID, internal_max_size_);
+      new_root->SetValueAt(0, page_id);
+      new_root->SetKeyAt(1, key);
+      new_root->SetValueAt(1, right_page_id);
+      new_root->IncreaseSize(2);
+      reinterpret_cast<BPlusTreePage *>(page->GetData())->SetParentPageId(new_page_id);
+      root_page_id_ = new_page_id;
+      height_++;
+      UpdateRootPageId(false);
+      page->WUnlatch();
+      buffer_pool_manager_->UnpinPage(page_id, true);
+      buffer_pool_manager_->UnpinPage(new_page_id, true);
+      if (pinned_levels_ > 0) {
+        UnswizzleBelowPinnedLevels();
+      }
+      return;
+    }
+    page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(page_id, true);
+
+    if (path->empty()) {
+      Page *leaf_page = FindLeafPageBLink(&key, true, path);
+      leaf_page->RUnlatch();
+      buffer_pool_manager_->UnpinPage(leaf_page->GetPageId(), false);
+      path->resize(path->size() - level);
+    }
+    page_id_t parent_id = path->back();
+    path->pop_back();
+    Page *parent_page = buffer_pool_manager_->FetchPage(parent_id);
+    parent_page->WLatch();
+    auto parent_node = reinterpret_cast<InternalPage *>(parent_page->GetData());
+    for (page_id_t next_page_id = RightLinkFor(parent_node, &key); next_page_id != INVALID_PAGE_ID;
+         next_page_id = RightLinkFor(parent_node, &key)) {
+      Page *next_page = buffer_pool_manager_->FetchPage(next_page_id);
+      next_page->WLatch();
+      parent_page->WUnlatch();
+      buffer_pool_manager_->UnpinPage(parent_page->GetPageId(), false);
+      parent_page = next_page;
+      parent_node = reinterpret_cast<InternalPage *>(parent_page->GetData());
+    }
+    if (parent_node->GetSize() < parent_node->GetMaxSize()) {
+      parent_node->Insert(std::make_pair(key, right_page_id), comparator_);
+      parent_page->WUnlatch();
+      buffer_pool_manager_->UnpinPage(parent_page->GetPageId(), true);
+      return;
+    }
+    page_id_t page_parent_bother_id;
+    Page *page_parent_bother = buffer_pool_manager_->NewPage(&page_parent_bother_id);
+    auto parent_bother_node = reinterpret_cast<InternalPage *>(page_parent_bother->GetData());
+    parent_bother_node->Init(page_parent_bother_id, INVALID_PAGE_ID, internal_max_size_);
+    Page *right_page = buffer_pool_manager_->FetchPage(right_page_id);
+    parent_node->Split(key, right_page, page_parent_bother, comparator_, buffer_pool_manager_);
+    buffer_pool_manager_->UnpinPage(right_page_id, true);
+    key = parent_bother_node->KeyAt(0);
+    right_page_id = page_parent_bother_id;
+    buffer_pool_manager_->UnpinPage(page_parent_bother_id, true);
+    page = parent_page;
+    level++;
+  }
+}
+
+/*
+ * Insert many key & value pairs. The pairs are sorted by key, then each descent inserts the
+ * following keys into the same write-latched leaf as long as they stay below its upper fence
+ * and the leaf does not have to split. Since such a leaf is safe, the ancestors are released
+ * right after the descent. A key that would split the leaf falls back to Insert().
+ * @return: the number of pairs inserted, duplicate keys are skipped
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::InsertBatch(std::vector<MappingType> *entries, Transaction *transaction) -> int {
+  Transaction local_transaction(INVALID_TXN_ID);
+  if (transaction == nullptr) {
+    transaction = &local_transaction;
+  }
+  std::sort(entries->begin(), entries->end(),
+            [this](const MappingType &lhs, const MappingType &rhs) { return comparator_(lhs.first, rhs.first) < 0; });
+  int inserted = 0;
+  size_t i = 0;
+  while (i < entries->size()) {
+    std::optional<KeyType> upper_fence;
+    Page *page_leaf = FindLeafPageRW((*entries)[i].first, transaction, INSERT, &upper_fence);
+    if (page_leaf != nullptr) {
+      // 只保留叶子的写锁，祖先立即释放
+      transaction->GetPageSet()->pop_back();
+      UnlockAndUnpin(transaction, INSERT);
+      transaction->AddIntoPageSet(page_leaf);
+      auto leaf_node = reinterpret_cast<LeafPage *>(page_leaf->GetData());
+      while (i < entries->size() && leaf_node->GetSize() < leaf_max_size_ - 1 &&
+             (!upper_fence.has_value() || comparator_((*entries)[i].first, *upper_fence) < 0)) {
+        int index = leaf_node->KeyIndex((*entries)[i].first, comparator_);
+        if (leaf_node->Insert((*entries)[i], index, comparator_)) {
+          entry_count_++;
+          modification_count_++;
+          inserted++;
+        }
+        i++;
+      }
+      bool leaf_full = leaf_node->GetSize() >= leaf_max_size_ - 1;
+      UnlockAndUnpin(transaction, INSERT);
+      if (!leaf_full) {
+        continue;
+      }
+    }
+    // 树为空或者叶子需要分裂，交给单条插入处理
+    if (i < entries->size()) {
+      if (Insert((*entries)[i].first, (*entries)[i].second, transaction)) {
+        inserted++;
+      }
+      i++;
+    }
+  }
+  return inserted;
+}
+
 INDEX_TEMPLATE_ARGUMENTS
 auto BPLUSTREE_TYPE::InsertInParentRW(Page *page_leaf, const KeyType &key, Page *page_bother, Transaction *transaction)
     -> void {
@@ -224,6 +710,7 @@ auto BPLUSTREE_TYPE::InsertInParentRW(Page *page_leaf, const KeyType &key, Page
     auto page_bother_node = reinterpret_cast<BPlusTreePage *>(page_bother->GetData());
     page_bother_node->SetParentPageId(new_page_id);
     root_page_id_ = new_page_id;
+    height_++;
     UpdateRootPageId(false);
     transaction->GetPageSet()->pop_back();
     page_leaf->WUnlatch();
@@ -274,6 +761,22 @@ void BPLUSTREE_TYPE::Remove(const KeyType &key, Transaction *transaction) {
   if (IsEmpty()) {
     return;
   }
+  if (blink_) {
+    // B-link 模式下只从叶子中删除，不合并也不收缩根，读者可能仍持有指向任何节点的链接
+    Page *leaf_page = FindLeafPageBLink(&key, true, nullptr, true);
+    bool deleted = reinterpret_cast<LeafPage *>(leaf_page->GetData())->Delete(key, comparator_);
+    if (deleted) {
+      entry_count_--;
+      modification_count_++;
+    }
+    leaf_page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(leaf_page->GetPageId(), deleted);
+    return;
+  }
+  Transaction local_transaction(INVALID_TXN_ID);
+  if (transaction == nullptr) {
+    transaction = &local_transaction;
+  }
   auto leaf_page = FindLeafPageRW(key, transaction, DELETE);
   if (leaf_page == nullptr) {
     return;
@@ -290,6 +793,8 @@ auto BPLUSTREE_TYPE::DeleteEntryRW(Page *&page, const KeyType &key, Transaction
     if (!leaf_node->Delete(key, comparator_)) {
       return;
     }
+    entry_count_--;
+    modification_count_++;
   } else {
     auto inter_node = reinterpret_cast<InternalPage *>(page->GetData());
     if (!inter_node->Delete(key, comparator_)) {
@@ -326,10 +831,13 @@ void BPLUSTREE_TYPE::AdjustRootPageRW(Page *page, Transaction *transaction) {
   auto b_node = reinterpret_cast<BPlusTreePage *>(page->GetData());
   if (b_node->IsLeafPage() && b_node->GetSize() == 0) {
     root_page_id_ = INVALID_PAGE_ID;
+    height_ = 0;
+    leaf_count_--;
   }
   if (!b_node->IsLeafPage() && b_node->GetSize() == 1) {
     auto inter_node = reinterpret_cast<InternalPage *>(b_node);
     root_page_id_ = inter_node->ValueAt(0);
+    height_--;
   }
   UpdateRootPageId(false);
   transaction->AddIntoDeletedPageSet(page->GetPageId());
@@ -414,8 +922,17 @@ void BPLUSTREE_TYPE::CoalesceRW(Page *page, Page *bother_page, const KeyType &pa
   if (b_node->IsLeafPage()) {
     auto leaf_bother_node = reinterpret_cast<LeafPage *>(bother_page->GetData());
     auto leaf_b_node = reinterpret_cast<LeafPage *>(page->GetData());
-    leaf_bother_node->Merge(page, buffer_pool_manager_);
-    leaf_bother_node->SetNextPageId(leaf_b_node->GetNextPageId());
+    page_id_t next_page_id = leaf_b_node->GetNextPageId();
+    leaf_bother_node->Merge(page);
+    leaf_bother_node->SetNextPageId(next_page_id);
+    leaf_count_--;
+    if (next_page_id != INVALID_PAGE_ID) {
+      Page *page_next = buffer_pool_manager_->FetchPage(next_page_id);
+      page_next->WLatch();
+      reinterpret_cast<LeafPage *>(page_next->GetData())->SetPrevPageId(bother_page->GetPageId());
+      page_next->WUnlatch();
+      buffer_pool_manager_->UnpinPage(next_page_id, true);
+    }
   } else {
     auto inter_bother_node = reinterpret_cast<InternalPage *>(bother_page->GetData());
     inter_bother_node->Merge(parent_key, page, buffer_pool_manager_);
@@ -441,19 +958,8 @@ auto BPLUSTREE_TYPE::Begin() -> INDEXITERATOR_TYPE {
   if (IsEmpty()) {
     return INDEXITERATOR_TYPE();
   }
-  Page *curr_page = buffer_pool_manager_->FetchPage(root_page_id_);
-  curr_page->RLatch();
-  auto curr_page_inter = reinterpret_cast<InternalPage *>(curr_page->GetData());
-  while (!curr_page_inter->IsLeafPage()) {
-    Page *next_page = buffer_pool_manager_->FetchPage(curr_page_inter->ValueAt(0));
-    next_page->RLatch();
-    auto next_page_inter = reinterpret_cast<InternalPage *>(next_page->GetData());
-    curr_page->RUnlatch();
-    buffer_pool_manager_->UnpinPage(curr_page->GetPageId(), false);
-    curr_page = next_page;
-    curr_page_inter = next_page_inter;
-  }
-  return INDEXITERATOR_TYPE(curr_page, 0, curr_page->GetPageId(), buffer_pool_manager_);
+  Page *curr_page = FindEdgeLeafPage(true);
+  return INDEXITERATOR_TYPE(this, curr_page, 0, buffer_pool_manager_, false, std::nullopt, true);
 }
 
 /*
@@ -492,11 +998,91 @@ auto BPLUSTREE_TYPE::End() -> INDEXITERATOR_TYPE {
   if (IsEmpty()) {
     return INDEXITERATOR_TYPE();
   }
+  Page *curr_page = FindEdgeLeafPage(false);
+  auto curr_node = reinterpret_cast<LeafPage *>(curr_page->GetData());
+  page_id_t page_id = curr_page->GetPageId();
+  int size = curr_node->GetSize();
+  curr_page->RUnlatch();
+  buffer_pool_manager_->UnpinPage(page_id, false);
+  return INDEXITERATOR_TYPE(nullptr, size, page_id, buffer_pool_manager_);
+}
+
+/*
+ * Input parameter is the key range, position at the first key inside the range in
+ * ascending order. The iterator stops by itself after the upper bound.
+ * @return : index iterator
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::Begin(const IndexKeyRange<KeyType> &range) -> INDEXITERATOR_TYPE {
+  if (IsEmpty()) {
+    return INDEXITERATOR_TYPE();
+  }
+  Page *leaf_page;
+  int index = 0;
+  if (range.lower_.has_value()) {
+    leaf_page = FindLeafPageRW(*range.lower_, nullptr, READ);
+    if (leaf_page == nullptr) {
+      return INDEXITERATOR_TYPE();
+    }
+    auto leaf_node = reinterpret_cast<LeafPage *>(leaf_page->GetData());
+    index = leaf_node->KeyIndex(*range.lower_, comparator_);
+    if (!range.lower_inclusive_ && index < leaf_node->GetSize() &&
+        comparator_(leaf_node->KeyAt(index), *range.lower_) == 0) {
+      index++;
+    }
+  } else {
+    leaf_page = FindEdgeLeafPage(true);
+  }
+  return INDEXITERATOR_TYPE(this, leaf_page, index, buffer_pool_manager_, false, range.upper_,
+                            range.upper_inclusive_);
+}
+
+/*
+ * Input parameter is the key range, position at the last key inside the range and
+ * walk the leaves backwards through their prev links, stopping after the lower bound.
+ * @return : index iterator
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::RBegin(const IndexKeyRange<KeyType> &range) -> INDEXITERATOR_TYPE {
+  if (IsEmpty()) {
+    return INDEXITERATOR_TYPE();
+  }
+  Page *leaf_page;
+  int index;
+  if (range.upper_.has_value()) {
+    leaf_page = FindLeafPageRW(*range.upper_, nullptr, READ);
+    if (leaf_page == nullptr) {
+      return INDEXITERATOR_TYPE();
+    }
+    auto leaf_node = reinterpret_cast<LeafPage *>(leaf_page->GetData());
+    index = leaf_node->KeyIndex(*range.upper_, comparator_);
+    if (!(range.upper_inclusive_ && index < leaf_node->GetSize() &&
+          comparator_(leaf_node->KeyAt(index), *range.upper_) == 0)) {
+      index--;
+    }
+  } else {
+    leaf_page = FindEdgeLeafPage(false);
+    index = reinterpret_cast<LeafPage *>(leaf_page->GetData())->GetSize() - 1;
+  }
+  return INDEXITERATOR_TYPE(this, leaf_page, index, buffer_pool_manager_, true, range.lower_,
+                            range.lower_inclusive_);
+}
+
+/*
+ * Descend along the leftmost (or rightmost) children and return the read-latched,
+ * pinned leaf page at that edge of the tree
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::FindEdgeLeafPage(bool leftmost) -> Page * {
+  if (blink_) {
+    return FindLeafPageBLink(nullptr, leftmost);
+  }
   Page *curr_page = buffer_pool_manager_->FetchPage(root_page_id_);
   curr_page->RLatch();
   auto curr_page_inter = reinterpret_cast<InternalPage *>(curr_page->GetData());
   while (!curr_page_inter->IsLeafPage()) {
-    Page *next_page = buffer_pool_manager_->FetchPage(curr_page_inter->ValueAt(curr_page_inter->GetSize() - 1));
+    page_id_t child_id = curr_page_inter->ValueAt(leftmost ? 0 : curr_page_inter->GetSize() - 1);
+    Page *next_page = buffer_pool_manager_->FetchPage(child_id);
     next_page->RLatch();
     auto next_page_inter = reinterpret_cast<InternalPage *>(next_page->GetData());
     curr_page->RUnlatch();
@@ -504,11 +1090,7 @@ auto BPLUSTREE_TYPE::End() -> INDEXITERATOR_TYPE {
     curr_page = next_page;
     curr_page_inter = next_page_inter;
   }
-  auto curr_node = reinterpret_cast<LeafPage *>(curr_page->GetData());
-  page_id_t page_id = curr_page->GetPageId();
-  curr_page->RUnlatch();
-  buffer_pool_manager_->UnpinPage(curr_page->GetPageId(), false);
-  return INDEXITERATOR_TYPE(curr_page, curr_node->GetSize(), page_id, buffer_pool_manager_);
+  return curr_page;
 }
 
 /**
@@ -11,15 +11,23 @@
 
 #include "storage/index/b_plus_tree_index.h"
 
+#include <algorithm>
+#include <optional>
+
+#include "common/macros.h"
+#include "type/type.h"
+
 namespace bustub {
 /*
  * Constructor
  */
 INDEX_TEMPLATE_ARGUMENTS
-BPLUSTREE_INDEX_TYPE::BPlusTreeIndex(std::unique_ptr<IndexMetadata> &&metadata, BufferPoolManager *buffer_pool_manager)
+BPLUSTREE_INDEX_TYPE::BPlusTreeIndex(std::unique_ptr<IndexMetadata> &&metadata, BufferPoolManager *buffer_pool_manager,
+                                     bool blink)
     : Index(std::move(metadata)),
       comparator_(GetMetadata()->GetKeySchema()),
-      container_(GetMetadata()->GetName(), buffer_pool_manager, comparator_) {}
+      container_(GetMetadata()->GetName(), buffer_pool_manager, comparator_, LEAF_PAGE_SIZE, INTERNAL_PAGE_SIZE,
+                 blink) {}
 
 INDEX_TEMPLATE_ARGUMENTS
 void BPLUSTREE_INDEX_TYPE::InsertEntry(const Tuple &key, RID rid, Transaction *transaction) {
@@ -48,6 +56,136 @@ void BPLUSTREE_INDEX_TYPE::ScanKey(const Tuple &key, std::vector<RID> *result, T
   container_.GetValue(index_key, result, transaction);
 }
 
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_INDEX_TYPE::ScanRange(IndexScanRange *range, bool reverse, std::size_t max_results,
+                                     std::vector<RID> *result, std::vector<Tuple> *entries,
+                                     Transaction *transaction) -> bool {
+  // construct the key range, a lower bound covers its prefix from the first key, an upper bound up to the last
+  IndexKeyRange<KeyType> key_range;
+  if (!range->lower_.empty()) {
+    key_range.lower_ = MakeBoundKey(range->lower_, !range->lower_inclusive_);
+    key_range.lower_inclusive_ = range->lower_inclusive_;
+  }
+  if (!range->upper_.empty()) {
+    key_range.upper_ = MakeBoundKey(range->upper_, range->upper_inclusive_);
+    key_range.upper_inclusive_ = range->upper_inclusive_;
+  }
+
+  auto iter = reverse ? container_.RBegin(key_range) : container_.Begin(key_range);
+  std::size_t count = 0;
+  for (; !iter.IsEnd() && count < max_results; ++iter, ++count) {
+    result->push_back((*iter).second);
+    if (entries != nullptr) {
+      auto *entry_schema = GetEntrySchema();
+      entries->emplace_back(KeyToValues((*iter).first, entry_schema->GetColumnCount()), entry_schema);
+    }
+    if (count + 1 == max_results) {
+      // the next call resumes right after the last key returned
+      auto last_key = KeyToValues((*iter).first, GetKeySchema()->GetColumnCount());
+      if (reverse) {
+        range->upper_ = std::move(last_key);
+        range->upper_inclusive_ = false;
+      } else {
+        range->lower_ = std::move(last_key);
+        range->lower_inclusive_ = false;
+      }
+    }
+  }
+  return iter.IsEnd();
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_INDEX_TYPE::InsertBatch(const std::vector<Tuple> &keys, const std::vector<RID> &rids,
+                                       Transaction *transaction) {
+  // construct the insert index keys, the tree sorts them
+  std::vector<MappingType> entries(keys.size());
+  for (std::size_t i = 0; i < keys.size(); i++) {
+    entries[i].first.SetFromKey(keys[i]);
+    entries[i].second = rids[i];
+  }
+  container_.InsertBatch(&entries, transaction);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_INDEX_TYPE::LookupBatch(const std::vector<Tuple> &keys, std::vector<std::vector<RID>> *results,
+                                       Transaction *transaction) {
+  // construct the scan index keys
+  std::vector<KeyType> index_keys(keys.size());
+  for (std::size_t i = 0; i < keys.size(); i++) {
+    index_keys[i].SetFromKey(keys[i]);
+  }
+  container_.LookupBatch(index_keys, results, transaction);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_INDEX_TYPE::CollectStats(std::size_t histogram_buckets) -> IndexStats {
+  IndexStats stats;
+  stats.height_ = container_.GetHeight();
+  stats.leaf_count_ = container_.GetLeafCount();
+  stats.entry_count_ = container_.GetEntryCount();
+  if (stats.leaf_count_ > 0) {
+    stats.avg_fill_ = static_cast<double>(stats.entry_count_) /
+                      static_cast<double>(stats.leaf_count_ * container_.GetLeafCapacity());
+  }
+  if (histogram_buckets == 0 || stats.entry_count_ == 0) {
+    return stats;
+  }
+
+  // one pass over the leaves: the leading column arrives sorted, so distinct values and bucket bounds fall out directly
+  auto *entry_schema = GetEntrySchema();
+  std::size_t per_bucket = std::max<std::size_t>(1, stats.entry_count_ / histogram_buckets);
+  std::size_t position = 0;
+  std::optional<Value> last;
+  for (auto iter = container_.Begin(); !iter.IsEnd(); ++iter, ++position) {
+    auto value = (*iter).first.ToValue(entry_schema, 0);
+    if (value.IsNull()) {
+      continue;
+    }
+    if (!last.has_value() || value.CompareNotEquals(*last) == CmpBool::CmpTrue) {
+      stats.distinct_keys_++;
+    }
+    if (stats.histogram_bounds_.empty() || position % per_bucket == 0) {
+      stats.histogram_bounds_.push_back(value);
+    }
+    last = std::move(value);
+  }
+  if (last.has_value() && stats.histogram_bounds_.back().CompareNotEquals(*last) == CmpBool::CmpTrue) {
+    stats.histogram_bounds_.push_back(*last);
+  }
+  return stats;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_INDEX_TYPE::MakeBoundKey(const std::vector<Value> &prefix, bool fill_with_max) const -> KeyType {
+  const auto *key_schema = GetKeySchema();
+  BUSTUB_ASSERT(prefix.size() <= key_schema->GetColumnCount(), "bound has more columns than the key");
+  std::vector<Value> values;
+  values.reserve(key_schema->GetColumnCount());
+  for (uint32_t i = 0; i < key_schema->GetColumnCount(); i++) {
+    auto type_id = key_schema->GetColumn(i).GetType();
+    if (i < prefix.size()) {
+      values.push_back(prefix[i].CastAs(type_id));
+    } else {
+      values.push_back(fill_with_max ? Type::GetMaxValue(type_id) : Type::GetMinValue(type_id));
+    }
+  }
+  KeyType key;
+  key.SetFromKey(Tuple{values, key_schema});
+  return key;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_INDEX_TYPE::KeyToValues(const KeyType &key, uint32_t column_count) const -> std::vector<Value> {
+  // the key columns lead the entry schema, so their offsets are the same in both schemas
+  auto *entry_schema = GetEntrySchema();
+  std::vector<Value> values;
+  values.reserve(column_count);
+  for (uint32_t i = 0; i < column_count; i++) {
+    values.push_back(key.ToValue(entry_schema, i));
+  }
+  return values;
+}
+
 INDEX_TEMPLATE_ARGUMENTS
 auto BPLUSTREE_INDEX_TYPE::GetBeginIterator() -> INDEXITERATOR_TYPE { return container_.Begin(); }
 
@@ -57,6 +195,16 @@ auto BPLUSTREE_INDEX_TYPE::GetBeginIterator(const KeyType &key) -> INDEXITERATOR
 INDEX_TEMPLATE_ARGUMENTS
 auto BPLUSTREE_INDEX_TYPE::GetEndIterator() -> INDEXITERATOR_TYPE { return container_.End(); }
 
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_INDEX_TYPE::GetBeginIterator(const IndexKeyRange<KeyType> &range) -> INDEXITERATOR_TYPE {
+  return container_.Begin(range);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_INDEX_TYPE::GetReverseBeginIterator(const IndexKeyRange<KeyType> &range) -> INDEXITERATOR_TYPE {
+  return container_.RBegin(range);
+}
+
 template class BPlusTreeIndex<GenericKey<4>, RID, GenericComparator<4>>;
 template class BPlusTreeIndex<GenericKey<8>, RID, GenericComparator<8>>;
 template class BPlusTreeIndex<GenericKey<16>, RID, GenericComparator<16>>;
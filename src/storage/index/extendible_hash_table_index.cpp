@@ -40,6 +40,13 @@ void HASH_TABLE_INDEX_TYPE::ScanKey(const Tuple &key, std::vector<RID> *result,
 
   container_.GetValue(transaction, index_key, result);
 }
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_INDEX_TYPE::ScanRange(IndexScanRange *range, bool reverse, std::size_t max_results,
+                                      std::vector<RID> *result, std::vector<Tuple> *entries,
+                                      Transaction *transaction) -> bool {
+  return ScanPointRange(range, result, entries, transaction);
+}
 template class ExtendibleHashTableIndex<GenericKey<4>, RID, GenericComparator<4>>;
 template class ExtendibleHashTableIndex<GenericKey<8>, RID, GenericComparator<8>>;
 template class ExtendibleHashTableIndex<GenericKey<16>, RID, GenericComparator<16>>;
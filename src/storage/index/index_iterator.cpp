@@ -4,6 +4,7 @@
 #include <cassert>
 
 #include "common/config.h"
+#include "storage/index/b_plus_tree.h"
 #include "storage/index/index_iterator.h"
 
 namespace bustub {
@@ -20,14 +21,58 @@ INDEXITERATOR_TYPE::IndexIterator(Page *curr_page, int index, page_id_t page_id,
     : page_id_(page_id), curr_page_(curr_page), index_(index), buffer_pool_manager_(bufferPoolManager) {}
 
 INDEX_TEMPLATE_ARGUMENTS
-INDEXITERATOR_TYPE::~IndexIterator() = default;  // NOLINT
+INDEXITERATOR_TYPE::IndexIterator(BPlusTree<KeyType, ValueType, KeyComparator> *tree, Page *curr_page, int index,
+                                  BufferPoolManager *bufferPoolManager, bool reverse, std::optional<KeyType> stop_key,
+                                  bool stop_inclusive)
+    : page_id_(curr_page == nullptr ? INVALID_PAGE_ID : curr_page->GetPageId()),
+      curr_page_(curr_page),
+      index_(index),
+      buffer_pool_manager_(bufferPoolManager),
+      tree_(tree),
+      reverse_(reverse),
+      stop_key_(std::move(stop_key)),
+      stop_inclusive_(stop_inclusive) {
+  Settle();
+}
 
 INDEX_TEMPLATE_ARGUMENTS
-auto INDEXITERATOR_TYPE::IsEnd() -> bool {
-  auto curr_node = reinterpret_cast<B_PLUS_TREE_LEAF_PAGE_TYPE *>(curr_page_->GetData());
-  return static_cast<bool>(index_ == curr_node->GetSize() && curr_node->GetNextPageId() == INVALID_PAGE_ID);
+INDEXITERATOR_TYPE::IndexIterator(IndexIterator &&other) noexcept
+    : page_id_(other.page_id_),
+      curr_page_(other.curr_page_),
+      index_(other.index_),
+      buffer_pool_manager_(other.buffer_pool_manager_),
+      tree_(other.tree_),
+      reverse_(other.reverse_),
+      stop_key_(std::move(other.stop_key_)),
+      stop_inclusive_(other.stop_inclusive_),
+      anchor_(std::move(other.anchor_)) {
+  other.curr_page_ = nullptr;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto INDEXITERATOR_TYPE::operator=(IndexIterator &&other) noexcept -> INDEXITERATOR_TYPE & {
+  if (this != &other) {
+    Finish(false);
+    page_id_ = other.page_id_;
+    curr_page_ = other.curr_page_;
+    index_ = other.index_;
+    buffer_pool_manager_ = other.buffer_pool_manager_;
+    tree_ = other.tree_;
+    reverse_ = other.reverse_;
+    stop_key_ = std::move(other.stop_key_);
+    stop_inclusive_ = other.stop_inclusive_;
+    anchor_ = std::move(other.anchor_);
+    other.curr_page_ = nullptr;
+  }
+  return *this;
 }
 
+INDEX_TEMPLATE_ARGUMENTS
+INDEXITERATOR_TYPE::~IndexIterator() { Finish(false); }  // NOLINT
+
+INDEX_TEMPLATE_ARGUMENTS
+auto INDEXITERATOR_TYPE::IsEnd() -> bool { return curr_page_ == nullptr; }
+
 INDEX_TEMPLATE_ARGUMENTS
 auto INDEXITERATOR_TYPE::operator*() -> const MappingType & {
   auto curr_node = reinterpret_cast<B_PLUS_TREE_LEAF_PAGE_TYPE *>(curr_page_->GetData());
@@ -36,22 +81,144 @@ auto INDEXITERATOR_TYPE::operator*() -> const MappingType & {
 
 INDEX_TEMPLATE_ARGUMENTS
 auto INDEXITERATOR_TYPE::operator++() -> INDEXITERATOR_TYPE & {
-  index_++;
+  if (curr_page_ == nullptr) {
+    return *this;
+  }
+  index_ += reverse_ ? -1 : 1;
+  Settle();
+  return *this;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void INDEXITERATOR_TYPE::Settle() {
+  while (curr_page_ != nullptr) {
+    auto curr_node = reinterpret_cast<B_PLUS_TREE_LEAF_PAGE_TYPE *>(curr_page_->GetData());
+    if (reverse_ && index_ < 0) {
+      StepToPrevLeaf();
+      continue;
+    }
+    if (!reverse_ && index_ >= curr_node->GetSize()) {
+      // 到达最后一个叶子页的末尾，保持 (page_id, size) 以便与 End() 比较
+      page_id_t next_page_id = curr_node->GetNextPageId();
+      if (next_page_id == INVALID_PAGE_ID) {
+        Finish(false);
+        return;
+      }
+      Page *next_page = buffer_pool_manager_->FetchPage(next_page_id);
+      if (next_page == nullptr) {
+        Finish(true);
+        return;
+      }
+      next_page->RLatch();
+      curr_page_->RUnlatch();
+      buffer_pool_manager_->UnpinPage(page_id_, false);
+      curr_page_ = next_page;
+      page_id_ = next_page_id;
+      index_ = 0;
+      continue;
+    }
+    if (stop_key_.has_value()) {
+      int cmp = tree_->comparator_(curr_node->KeyAt(index_), *stop_key_);
+      if ((reverse_ ? cmp < 0 : cmp > 0) || (cmp == 0 && !stop_inclusive_)) {
+        Finish(true);
+      }
+    }
+    return;
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void INDEXITERATOR_TYPE::StepToPrevLeaf() {
   auto curr_node = reinterpret_cast<B_PLUS_TREE_LEAF_PAGE_TYPE *>(curr_page_->GetData());
-  if (index_ == curr_node->GetSize() && curr_node->GetNextPageId() != INVALID_PAGE_ID) {
-    auto next_page = buffer_pool_manager_->FetchPage(curr_node->GetNextPageId());
-    next_page->RLatch();
-    curr_page_->RUnlatch();
-    buffer_pool_manager_->UnpinPage(curr_node->GetPageId(), false);
-    curr_page_ = next_page;
-    page_id_ = curr_page_->GetPageId();
-    index_ = 0;
+  page_id_t prev_page_id = curr_node->GetPrevPageId();
+  if (prev_page_id == INVALID_PAGE_ID) {
+    Finish(true);
+    return;
+  }
+  if (tree_->blink_) {
+    StepToPrevLeafBLink(prev_page_id);
+    return;
+  }
+  // 写者按从左到右的顺序加锁，因此反向移动前必须先释放当前页，再检查左邻居是否仍指向它
+  // 空叶子没有键，沿用上一个非空叶子的首键作为重新定位的锚点，像正向迭代一样跳过它
+  if (curr_node->GetSize() > 0) {
+    anchor_ = curr_node->KeyAt(0);
+  } else if (!anchor_.has_value()) {
+    Finish(true);
+    return;
   }
-  if (index_ == curr_node->GetSize() && curr_node->GetNextPageId() == INVALID_PAGE_ID) {
+  page_id_t old_page_id = page_id_;
+  KeyType anchor = *anchor_;
+  curr_page_->RUnlatch();
+  buffer_pool_manager_->UnpinPage(old_page_id, false);
+  curr_page_ = nullptr;
+
+  Page *prev_page = buffer_pool_manager_->FetchPage(prev_page_id);
+  if (prev_page != nullptr) {
+    prev_page->RLatch();
+    auto prev_node = reinterpret_cast<B_PLUS_TREE_LEAF_PAGE_TYPE *>(prev_page->GetData());
+    if (prev_node->IsLeafPage() && prev_node->GetNextPageId() == old_page_id) {
+      curr_page_ = prev_page;
+      page_id_ = prev_page_id;
+      index_ = prev_node->GetSize() - 1;
+      return;
+    }
+    prev_page->RUnlatch();
+    buffer_pool_manager_->UnpinPage(prev_page_id, false);
+  }
+  // 左邻居在释放期间发生了分裂或合并，从根重新定位到 anchor 之前的位置
+  Page *leaf_page = tree_->FindLeafPageRW(anchor, nullptr, READ);
+  if (leaf_page == nullptr) {
+    Finish(true);
+    return;
+  }
+  auto leaf_node = reinterpret_cast<B_PLUS_TREE_LEAF_PAGE_TYPE *>(leaf_page->GetData());
+  curr_page_ = leaf_page;
+  page_id_ = leaf_page->GetPageId();
+  index_ = leaf_node->KeyIndex(anchor, tree_->comparator_) - 1;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void INDEXITERATOR_TYPE::StepToPrevLeafBLink(page_id_t prev_page_id) {
+  // B-link 模式下叶子不会被合并，左邻居在释放期间只可能分裂：从它向右走到 next 指向当前页的叶子
+  page_id_t old_page_id = page_id_;
+  curr_page_->RUnlatch();
+  buffer_pool_manager_->UnpinPage(old_page_id, false);
+  curr_page_ = nullptr;
+
+  page_id_t page_id = prev_page_id;
+  while (page_id != INVALID_PAGE_ID) {
+    Page *page = buffer_pool_manager_->FetchPage(page_id);
+    if (page == nullptr) {
+      break;
+    }
+    page->RLatch();
+    auto node = reinterpret_cast<B_PLUS_TREE_LEAF_PAGE_TYPE *>(page->GetData());
+    page_id_t next_page_id = node->GetNextPageId();
+    if (next_page_id == old_page_id) {
+      curr_page_ = page;
+      page_id_ = page_id;
+      index_ = node->GetSize() - 1;
+      return;
+    }
+    page->RUnlatch();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    page_id = next_page_id;
+  }
+  Finish(true);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void INDEXITERATOR_TYPE::Finish(bool hit_bound) {
+  if (curr_page_ != nullptr) {
     curr_page_->RUnlatch();
-    buffer_pool_manager_->UnpinPage(curr_node->GetPageId(), false);
+    buffer_pool_manager_->UnpinPage(page_id_, false);
+    curr_page_ = nullptr;
+  }
+  if (hit_bound || reverse_) {
+    page_id_ = INVALID_PAGE_ID;
+    index_ = 0;
   }
-  return *this;
 }
 
 template class IndexIterator<GenericKey<4>, RID, GenericComparator<4>>;
@@ -0,0 +1,75 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// index_stats.cpp
+//
+// Identification: src/storage/index/index_stats.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/index/index_stats.h"
+
+#include <algorithm>
+
+namespace bustub {
+
+namespace {
+
+/** @return true if the position of a value between two bounds can be interpolated */
+auto IsNumeric(const Value &value) -> bool {
+  switch (value.GetTypeId()) {
+    case TypeId::TINYINT:
+    case TypeId::SMALLINT:
+    case TypeId::INTEGER:
+    case TypeId::BIGINT:
+    case TypeId::DECIMAL:
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+auto IndexStats::EstimateSelectivity(const std::optional<Value> &lower, const std::optional<Value> &upper) const
+    -> double {
+  if (histogram_bounds_.empty()) {
+    return 1;
+  }
+  if (lower.has_value() && upper.has_value() && lower->CompareEquals(*upper) == CmpBool::CmpTrue) {
+    return distinct_keys_ == 0 ? 1 : 1.0 / static_cast<double>(distinct_keys_);
+  }
+  double fraction = (upper.has_value() ? FractionBelow(*upper) : 1) - (lower.has_value() ? FractionBelow(*lower) : 0);
+  // a range holds at least one value when it is not empty
+  double floor = distinct_keys_ == 0 ? 0 : 1.0 / static_cast<double>(distinct_keys_);
+  return std::clamp(fraction, floor, 1.0);
+}
+
+auto IndexStats::FractionBelow(const Value &value) const -> double {
+  if (value.CompareLessThanEquals(histogram_bounds_.front()) == CmpBool::CmpTrue) {
+    return 0;
+  }
+  if (value.CompareGreaterThan(histogram_bounds_.back()) == CmpBool::CmpTrue) {
+    return 1;
+  }
+  // the first bound that is not smaller than the value ends the bucket holding it
+  std::size_t bucket = 1;
+  while (bucket + 1 < histogram_bounds_.size() &&
+         histogram_bounds_[bucket].CompareLessThan(value) == CmpBool::CmpTrue) {
+    bucket++;
+  }
+  const auto &low = histogram_bounds_[bucket - 1];
+  const auto &high = histogram_bounds_[bucket];
+  double within = 0.5;
+  if (IsNumeric(value) && IsNumeric(low) && IsNumeric(high)) {
+    auto low_d = low.CastAs(TypeId::DECIMAL).GetAs<double>();
+    auto high_d = high.CastAs(TypeId::DECIMAL).GetAs<double>();
+    auto value_d = value.CastAs(TypeId::DECIMAL).GetAs<double>();
+    within = high_d > low_d ? std::clamp((value_d - low_d) / (high_d - low_d), 0.0, 1.0) : 0.5;
+  }
+  auto buckets = static_cast<double>(histogram_bounds_.size() - 1);
+  return (static_cast<double>(bucket - 1) + within) / buckets;
+}
+
+}  // namespace bustub
@@ -31,7 +31,22 @@ void B_PLUS_TREE_INTERNAL_PAGE_TYPE::Init(page_id_t page_id, page_id_t parent_id
   SetMaxSize(max_size);
   SetPageType(IndexPageType::INTERNAL_PAGE);
   SetSize(0);
+  next_page_id_ = INVALID_PAGE_ID;
+  has_high_key_ = false;
 }
+
+/*
+ * Helper methods to get the right sibling and the high key, the high key is only
+ * valid if HasHighKey()
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_INTERNAL_PAGE_TYPE::GetNextPageId() const -> page_id_t { return next_page_id_; }
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_INTERNAL_PAGE_TYPE::HasHighKey() const -> bool { return has_high_key_; }
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_INTERNAL_PAGE_TYPE::GetHighKey() const -> const KeyType & { return high_key_; }
 /*
  * Helper method to get/set the key associated with input "index"(a.k.a
  * array offset)
@@ -61,6 +76,12 @@ void B_PLUS_TREE_INTERNAL_PAGE_TYPE::SetValueAt(int index, const ValueType &valu
 // 查找与key相对应的value
 INDEX_TEMPLATE_ARGUMENTS
 auto B_PLUS_TREE_INTERNAL_PAGE_TYPE::Find(const KeyType &key, const KeyComparator &keyComparator) -> ValueType {
+  return array_[ChildIndex(key, keyComparator)].second;
+}
+
+// 返回 key 所在子树在 array_ 中的下标
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_INTERNAL_PAGE_TYPE::ChildIndex(const KeyType &key, const KeyComparator &keyComparator) const -> int {
   int l = 1;
   int r = GetSize();
   while (l < r) {
@@ -71,7 +92,7 @@ auto B_PLUS_TREE_INTERNAL_PAGE_TYPE::Find(const KeyType &key, const KeyComparato
       r = mid;
     }
   }
-  return array_[r - 1].second;
+  return r - 1;
 }
 
 // 在非叶子节点插入值
@@ -137,6 +158,13 @@ void B_PLUS_TREE_INTERNAL_PAGE_TYPE::Split(const KeyType &key, Page *page_bother
     buffer_pool_manager_->UnpinPage(child->GetPageId(), true);
   }
   free(tmp);
+  // 右兄弟链接：bother 继承原来的右邻居与 high key，自身的 high key 变为上推的 key
+  page_parent_node->next_page_id_ = next_page_id_;
+  page_parent_node->has_high_key_ = has_high_key_;
+  page_parent_node->high_key_ = high_key_;
+  next_page_id_ = page_parent_page->GetPageId();
+  has_high_key_ = true;
+  high_key_ = page_parent_node->array_[0].first;
 }
 
 /*
@@ -205,8 +233,7 @@ auto B_PLUS_TREE_INTERNAL_PAGE_TYPE::Merge(const KeyType &key, Page *right_page,
     array_[i] = std::make_pair(right->KeyAt(j), right->ValueAt(j));
     IncreaseSize(1);
   }
-  buffer_pool_manager_->UnpinPage(right->GetPageId(), true);
-  buffer_pool_manager_->DeletePage(right->GetPageId());
+  // right_page 仍被调用者加锁，由调用者释放并删除
   for (int i = size; i < GetSize(); i++) {
     page_id_t child_page_id = ValueAt(i);
     auto child_page = buffer_pool_manager_->FetchPage(child_page_id);
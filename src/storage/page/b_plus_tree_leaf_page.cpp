@@ -24,13 +24,15 @@ namespace bustub {
 /**
  * Init method after creating a new leaf page
  * Including set page type, set current size to zero, set page id/parent id, set
- * next page id and set max size
+ * next/prev page id and set max size
  */
 INDEX_TEMPLATE_ARGUMENTS
 void B_PLUS_TREE_LEAF_PAGE_TYPE::Init(page_id_t page_id, page_id_t parent_id, int max_size) {
   SetPageId(page_id);
   SetParentPageId(parent_id);
   SetNextPageId(INVALID_PAGE_ID);
+  SetPrevPageId(INVALID_PAGE_ID);
+  has_high_key_ = false;
   SetMaxSize(max_size);
   SetPageType(IndexPageType::LEAF_PAGE);
   SetSize(0);
@@ -45,6 +47,24 @@ auto B_PLUS_TREE_LEAF_PAGE_TYPE::GetNextPageId() const -> page_id_t { return nex
 INDEX_TEMPLATE_ARGUMENTS
 void B_PLUS_TREE_LEAF_PAGE_TYPE::SetNextPageId(page_id_t next_page_id) { next_page_id_ = next_page_id; }
 
+/**
+ * Helper methods to set/get prev page id
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_LEAF_PAGE_TYPE::GetPrevPageId() const -> page_id_t { return prev_page_id_; }
+
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_LEAF_PAGE_TYPE::SetPrevPageId(page_id_t prev_page_id) { prev_page_id_ = prev_page_id; }
+
+/**
+ * Helper methods to get the high key, only valid if HasHighKey()
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_LEAF_PAGE_TYPE::HasHighKey() const -> bool { return has_high_key_; }
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_LEAF_PAGE_TYPE::GetHighKey() const -> const KeyType & { return high_key_; }
+
 /*
  * Helper method to find and return the key associated with input "index"(a.k.a
  * array offset)
@@ -99,7 +119,14 @@ auto B_PLUS_TREE_LEAF_PAGE_TYPE::Split(Page *bother_page) -> void {
     IncreaseSize(-1);
     leaf_bother_page->IncreaseSize(1);
   }
+  // bother 继承原来的 high key，自身的 high key 变为 bother 的第一个 key
+  leaf_bother_page->has_high_key_ = has_high_key_;
+  leaf_bother_page->high_key_ = high_key_;
+  has_high_key_ = true;
+  high_key_ = leaf_bother_page->array_[0].first;
+  // bother 的右邻居（若存在）的 prev 由调用者负责修正
   leaf_bother_page->next_page_id_ = next_page_id_;
+  leaf_bother_page->prev_page_id_ = GetPageId();
   SetNextPageId(bother_page->GetPageId());
 }
 
@@ -132,15 +159,14 @@ auto B_PLUS_TREE_LEAF_PAGE_TYPE::Delete(const KeyType &key, const KeyComparator
 
 // 合并右边的叶子节点
 INDEX_TEMPLATE_ARGUMENTS
-auto B_PLUS_TREE_LEAF_PAGE_TYPE::Merge(Page *right_page, BufferPoolManager *buffer_pool_manager_) -> void {
+auto B_PLUS_TREE_LEAF_PAGE_TYPE::Merge(Page *right_page) -> void {
   auto right = reinterpret_cast<B_PLUS_TREE_LEAF_PAGE_TYPE *>(right_page->GetData());
   for (int i = GetSize(), j = 0; j < right->GetSize(); ++j, ++i) {
     array_[i] = std::make_pair(right->KeyAt(j), right->ValueAt(j));
     IncreaseSize(1);
   }
+  // right_page 仍被调用者加锁，由调用者释放并删除
   right->SetSize(0);
-  buffer_pool_manager_->UnpinPage(right->GetPageId(), true);
-  buffer_pool_manager_->DeletePage(right->GetPageId());
 }
 
 // 从头插入元素
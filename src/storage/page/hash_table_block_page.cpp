@@ -11,36 +11,97 @@
 //===----------------------------------------------------------------------===//
 
 #include "storage/page/hash_table_block_page.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include <algorithm>
+
+#include "common/macros.h"
 #include "storage/index/generic_key.h"
 
 namespace bustub {
 
+namespace {
+
+/** @return a mask with bit i set if control byte i of the group equals the byte */
+auto MatchByte(const int8_t *group, int8_t byte) -> uint32_t {
+#ifdef __SSE2__
+  auto control = _mm_loadu_si128(reinterpret_cast<const __m128i *>(group));
+  return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(control, _mm_set1_epi8(byte))));
+#else
+  uint32_t mask = 0;
+  for (uint32_t i = 0; i < BLOCK_GROUP_SIZE; i++) {
+    mask |= static_cast<uint32_t>(group[i] == byte) << i;
+  }
+  return mask;
+#endif
+}
+
+}  // namespace
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_BLOCK_TYPE::Init() {
+  std::fill(control_, control_ + BLOCK_ARRAY_SIZE, EMPTY);
+}
+
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_BLOCK_TYPE::KeyAt(slot_offset_t bucket_ind) const -> KeyType {
-  return {};
+  return array_[bucket_ind].first;
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_BLOCK_TYPE::ValueAt(slot_offset_t bucket_ind) const -> ValueType {
-  return {};
+  return array_[bucket_ind].second;
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
-auto HASH_TABLE_BLOCK_TYPE::Insert(slot_offset_t bucket_ind, const KeyType &key, const ValueType &value) -> bool {
-  return false;
+void HASH_TABLE_BLOCK_TYPE::Insert(slot_offset_t bucket_ind, const KeyType &key, const ValueType &value,
+                                   uint8_t fingerprint) {
+  BUSTUB_ASSERT(!IsReadable(bucket_ind), "the slot already holds a pair");
+  array_[bucket_ind] = MappingType(key, value);
+  control_[bucket_ind] = static_cast<int8_t>(fingerprint & 0x7F);
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
-void HASH_TABLE_BLOCK_TYPE::Remove(slot_offset_t bucket_ind) {}
+void HASH_TABLE_BLOCK_TYPE::Remove(slot_offset_t bucket_ind, bool tombstone) {
+  control_[bucket_ind] = tombstone ? DELETED : EMPTY;
+}
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_BLOCK_TYPE::IsOccupied(slot_offset_t bucket_ind) const -> bool {
-  return false;
+  return control_[bucket_ind] != EMPTY;
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_BLOCK_TYPE::IsReadable(slot_offset_t bucket_ind) const -> bool {
-  return false;
+  return control_[bucket_ind] >= 0;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_BLOCK_TYPE::MatchFingerprint(size_t group, uint8_t fingerprint) const -> uint32_t {
+  return MatchByte(control_ + group * BLOCK_GROUP_SIZE, static_cast<int8_t>(fingerprint & 0x7F));
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_BLOCK_TYPE::MatchEmpty(size_t group) const -> uint32_t {
+  return MatchByte(control_ + group * BLOCK_GROUP_SIZE, EMPTY);
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_BLOCK_TYPE::MatchFree(size_t group) const -> uint32_t {
+  // empty and tombstone are the only control bytes with the sign bit set
+  const int8_t *control = control_ + group * BLOCK_GROUP_SIZE;
+#ifdef __SSE2__
+  return static_cast<uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(control))));
+#else
+  uint32_t mask = 0;
+  for (uint32_t i = 0; i < BLOCK_GROUP_SIZE; i++) {
+    mask |= static_cast<uint32_t>(control[i] < 0) << i;
+  }
+  return mask;
+#endif
 }
 
 // DO NOT REMOVE ANYTHING BELOW THIS LINE
@@ -12,23 +12,56 @@
 
 #include "storage/page/hash_table_header_page.h"
 
+#include "common/macros.h"
+
 namespace bustub {
-auto HashTableHeaderPage::GetBlockPageId(size_t index) -> page_id_t { return 0; }
+void HashTableHeaderPage::Init(page_id_t page_id) {
+  static_assert(sizeof(HashTableHeaderPage) <= 48, "the block page ids start within the first 48 bytes");
+  lsn_ = 0;
+  size_ = 0;
+  page_id_ = page_id;
+  next_ind_ = 0;
+  next_page_id_ = INVALID_PAGE_ID;
+  num_entries_ = 0;
+  num_tombstones_ = 0;
+}
+
+auto HashTableHeaderPage::GetBlockPageId(size_t index) -> page_id_t {
+  BUSTUB_ASSERT(index < next_ind_, "no such block");
+  return block_page_ids_[index];
+}
+
+auto HashTableHeaderPage::GetPageId() const -> page_id_t { return page_id_; }
+
+void HashTableHeaderPage::SetPageId(bustub::page_id_t page_id) { page_id_ = page_id; }
+
+auto HashTableHeaderPage::GetLSN() const -> lsn_t { return lsn_; }
+
+void HashTableHeaderPage::SetLSN(lsn_t lsn) { lsn_ = lsn; }
+
+auto HashTableHeaderPage::GetNextPageId() const -> page_id_t { return next_page_id_; }
+
+void HashTableHeaderPage::SetNextPageId(page_id_t next_page_id) { next_page_id_ = next_page_id; }
+
+auto HashTableHeaderPage::GetNumEntries() const -> size_t { return num_entries_; }
 
-auto HashTableHeaderPage::GetPageId() const -> page_id_t { return 0; }
+void HashTableHeaderPage::SetNumEntries(size_t num_entries) { num_entries_ = num_entries; }
 
-void HashTableHeaderPage::SetPageId(bustub::page_id_t page_id) {}
+auto HashTableHeaderPage::GetNumTombstones() const -> size_t { return num_tombstones_; }
 
-auto HashTableHeaderPage::GetLSN() const -> lsn_t { return 0; }
+void HashTableHeaderPage::SetNumTombstones(size_t num_tombstones) { num_tombstones_ = num_tombstones; }
 
-void HashTableHeaderPage::SetLSN(lsn_t lsn) {}
+void HashTableHeaderPage::AddBlockPageId(page_id_t page_id) {
+  BUSTUB_ASSERT(!IsFull(), "the header page is full");
+  block_page_ids_[next_ind_++] = page_id;
+}
 
-void HashTableHeaderPage::AddBlockPageId(page_id_t page_id) {}
+auto HashTableHeaderPage::NumBlocks() -> size_t { return next_ind_; }
 
-auto HashTableHeaderPage::NumBlocks() -> size_t { return 0; }
+auto HashTableHeaderPage::IsFull() -> bool { return next_ind_ == HEADER_ARRAY_SIZE; }
 
-void HashTableHeaderPage::SetSize(size_t size) {}
+void HashTableHeaderPage::SetSize(size_t size) { size_ = size; }
 
-auto HashTableHeaderPage::GetSize() const -> size_t { return 0; }
+auto HashTableHeaderPage::GetSize() const -> size_t { return size_; }
 
 }  // namespace bustub
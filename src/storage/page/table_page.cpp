@@ -326,6 +326,22 @@ auto TablePage::GetTuple(const RID &rid, Tuple *tuple, Transaction *txn, LockMan
   return true;
 }
 
+void TablePage::ReadTuple(const RID &rid, Tuple *tuple) {
+  uint32_t slot_num = rid.GetSlotNum();
+  uint32_t tuple_size = GetTupleSize(slot_num);
+  BUSTUB_ASSERT(slot_num < GetTupleCount() && !IsDeleted(tuple_size), "Reading a slot that holds no tuple.");
+  if (!tuple->allocated_ || tuple->size_ != tuple_size) {
+    if (tuple->allocated_) {
+      delete[] tuple->data_;
+    }
+    tuple->data_ = new char[tuple_size];
+    tuple->size_ = tuple_size;
+    tuple->allocated_ = true;
+  }
+  memcpy(tuple->data_, GetData() + GetTupleOffsetAtSlot(slot_num), tuple_size);
+  tuple->rid_ = rid;
+}
+
 auto TablePage::GetFirstTupleRid(RID *first_rid) -> bool {
   // Find and return the first valid tuple.
   for (uint32_t i = 0; i < GetTupleCount(); ++i) {
@@ -176,6 +176,30 @@ auto TableHeap::GetTuple(const RID &rid, Tuple *tuple, Transaction *txn, bool ac
   return res;
 }
 
+auto TableHeap::GetTuples(std::vector<RID>::const_iterator begin, std::vector<RID>::const_iterator end,
+                          std::vector<Tuple> *tuples, Transaction *txn) -> bool {
+  if (begin == end) {
+    return true;
+  }
+  auto page_id = begin->GetPageId();
+  auto page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+  if (page == nullptr) {
+    txn->SetState(TransactionState::ABORTED);
+    return false;
+  }
+  page->RLatch();
+  for (auto rid = begin; rid != end; ++rid) {
+    BUSTUB_ASSERT(rid->GetPageId() == page_id, "all rids should be on the same page");
+    Tuple tuple;
+    if (page->GetTuple(*rid, &tuple, txn, lock_manager_)) {
+      tuples->push_back(tuple);
+    }
+  }
+  page->RUnlatch();
+  buffer_pool_manager_->UnpinPage(page_id, false);
+  return true;
+}
+
 auto TableHeap::Begin(Transaction *txn) -> TableIterator {
   // Start an iterator from the first page.
   // TODO(Wuwen): Hacky fix for now. Removing empty pages is a better way to handle this.
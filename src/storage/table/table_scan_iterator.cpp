@@ -0,0 +1,47 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// table_scan_iterator.cpp
+//
+// Identification: src/storage/table/table_scan_iterator.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/table/table_scan_iterator.h"
+
+#include <cstring>
+
+#include "storage/table/table_heap.h"
+
+namespace bustub {
+
+TableScanIterator::TableScanIterator(TableHeap *table_heap)
+    : table_heap_(table_heap), page_(std::make_unique<TablePage>()), next_page_id_(table_heap->GetFirstPageId()) {}
+
+auto TableScanIterator::Next(Tuple *tuple) -> bool {
+  while (!has_rid_) {
+    if (next_page_id_ == INVALID_PAGE_ID) {
+      return false;
+    }
+    LoadPage(next_page_id_);
+  }
+  page_->ReadTuple(rid_, tuple);
+  has_rid_ = page_->GetNextTupleRid(rid_, &rid_);
+  return true;
+}
+
+void TableScanIterator::LoadPage(page_id_t page_id) {
+  auto *bpm = table_heap_->buffer_pool_manager_;
+  auto *page = static_cast<TablePage *>(bpm->FetchPage(page_id));
+  BUSTUB_ENSURE(page != nullptr, "BPM full");  // all pages are pinned
+  page->RLatch();
+  memcpy(page_->GetData(), page->GetData(), BUSTUB_PAGE_SIZE);
+  page->RUnlatch();
+  bpm->UnpinPage(page_id, false);
+
+  next_page_id_ = page_->GetNextPageId();
+  has_rid_ = page_->GetFirstTupleRid(&rid_);
+}
+
+}  // namespace bustub
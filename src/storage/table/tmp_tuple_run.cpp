@@ -0,0 +1,83 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tmp_tuple_run.cpp
+//
+// Identification: src/storage/table/tmp_tuple_run.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/table/tmp_tuple_run.h"
+
+#include "common/exception.h"
+
+namespace bustub {
+
+TmpTupleRun::~TmpTupleRun() {
+  Finish();
+  for (auto page_id : page_ids_) {
+    bpm_->DeletePage(page_id);
+  }
+}
+
+auto TmpTupleRun::Append(const Tuple &tuple) -> TmpTuple {
+  TmpTuple out(INVALID_PAGE_ID, 0);
+  if (write_page_ != nullptr && write_page_->Insert(tuple, &out)) {
+    num_tuples_++;
+    return out;
+  }
+  Finish();
+
+  page_id_t page_id;
+  write_page_ = reinterpret_cast<TmpTuplePage *>(bpm_->NewPage(&page_id));
+  if (write_page_ == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "no buffer pool frame left for a temporary page");
+  }
+  page_ids_.push_back(page_id);
+  write_page_->Init(page_id, BUSTUB_PAGE_SIZE);
+  if (!write_page_->Insert(tuple, &out)) {
+    throw Exception(ExceptionType::OUT_OF_RANGE, "tuple is too large for a temporary page");
+  }
+  num_tuples_++;
+  return out;
+}
+
+void TmpTupleRun::Finish() {
+  if (write_page_ != nullptr) {
+    bpm_->UnpinPage(write_page_->GetTablePageId(), true);
+    write_page_ = nullptr;
+  }
+}
+
+auto TmpTupleRun::Reader::Next(Tuple *tuple) -> bool {
+  while (offsets_.empty()) {
+    Release();
+    if (page_idx_ == run_->page_ids_.size()) {
+      return false;
+    }
+    page_ = reinterpret_cast<TmpTuplePage *>(run_->bpm_->FetchPage(run_->page_ids_[page_idx_++]));
+    if (page_ == nullptr) {
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "no buffer pool frame left to read a temporary page");
+    }
+    // Tuples are packed from the end of the page towards its header, newest first.
+    for (size_t offset = page_->GetFreeSpacePointer(); offset < BUSTUB_PAGE_SIZE;) {
+      offsets_.push_back(offset);
+      offset += sizeof(uint32_t) + *reinterpret_cast<uint32_t *>(page_->GetData() + offset);
+    }
+  }
+  page_->Get(offsets_.back(), tuple);
+  offsets_.pop_back();
+  return true;
+}
+
+void TmpTupleRun::Reader::Release() {
+  if (page_ != nullptr) {
+    run_->bpm_->UnpinPage(page_->GetTablePageId(), false);
+    page_ = nullptr;
+  }
+}
+
+}  // namespace bustub
@@ -17,13 +17,14 @@
 #include "common/logger.h"
 #include "gtest/gtest.h"
 #include "storage/disk/disk_manager.h"
+#include "storage/page/hash_table_block_page.h"
 #include "storage/page/hash_table_bucket_page.h"
 #include "storage/page/hash_table_directory_page.h"
 
 namespace bustub {
 
 // NOLINTNEXTLINE
-TEST(HashTablePageTest, DISABLED_DirectoryPageSampleTest) {
+TEST(HashTablePageTest, DirectoryPageSampleTest) {
   auto *disk_manager = new DiskManager("test.db");
   auto *bpm = new BufferPoolManagerInstance(5, disk_manager);
 
@@ -57,7 +58,7 @@ TEST(HashTablePageTest, DISABLED_DirectoryPageSampleTest) {
 }
 
 // NOLINTNEXTLINE
-TEST(HashTablePageTest, DISABLED_BucketPageSampleTest) {
+TEST(HashTablePageTest, BucketPageSampleTest) {
   auto *disk_manager = new DiskManager("test.db");
   auto *bpm = new BufferPoolManagerInstance(5, disk_manager);
 
@@ -114,4 +115,48 @@ TEST(HashTablePageTest, DISABLED_BucketPageSampleTest) {
   delete bpm;
 }
 
+// NOLINTNEXTLINE
+TEST(HashTablePageTest, BlockPageSampleTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManagerInstance(5, disk_manager);
+
+  page_id_t block_page_id = INVALID_PAGE_ID;
+  auto block_page = reinterpret_cast<HashTableBlockPage<int, int, IntComparator> *>(
+      bpm->NewPage(&block_page_id, nullptr)->GetData());
+  block_page->Init();
+  EXPECT_EQ(0xFFFF, block_page->MatchEmpty(0));
+  EXPECT_EQ(0xFFFF, block_page->MatchFree(0));
+
+  // slots 0, 3 and 17 get fingerprint 5, slot 1 fingerprint 6
+  block_page->Insert(0, 10, 100, 5);
+  block_page->Insert(3, 13, 130, 5);
+  block_page->Insert(1, 11, 110, 6);
+  block_page->Insert(17, 27, 270, 5);
+  EXPECT_EQ(0b1001, block_page->MatchFingerprint(0, 5));
+  EXPECT_EQ(0b10, block_page->MatchFingerprint(0, 6));
+  EXPECT_EQ(0, block_page->MatchFingerprint(0, 7));
+  EXPECT_EQ(0b10, block_page->MatchFingerprint(1, 5));
+  EXPECT_EQ(0xFFFF & ~0b1011U, block_page->MatchEmpty(0));
+  EXPECT_EQ(13, block_page->KeyAt(3));
+  EXPECT_EQ(130, block_page->ValueAt(3));
+
+  // a tombstone is occupied but neither readable nor empty, and matches no fingerprint
+  block_page->Remove(3, true);
+  EXPECT_TRUE(block_page->IsOccupied(3));
+  EXPECT_FALSE(block_page->IsReadable(3));
+  EXPECT_EQ(0b1, block_page->MatchFingerprint(0, 5));
+  EXPECT_EQ(0xFFFF & ~0b1011U, block_page->MatchEmpty(0));
+  EXPECT_EQ(0xFFFF & ~0b0011U, block_page->MatchFree(0));
+  block_page->Remove(1, false);
+  EXPECT_FALSE(block_page->IsOccupied(1));
+  EXPECT_TRUE(block_page->IsReadable(0));
+  EXPECT_EQ(0, block_page->MatchFingerprint(0, 6));
+
+  bpm->UnpinPage(block_page_id, true, nullptr);
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
 }  // namespace bustub
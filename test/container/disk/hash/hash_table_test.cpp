@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <thread>  // NOLINT
 #include <vector>
 
@@ -24,7 +25,7 @@ namespace bustub {
 // NOLINTNEXTLINE
 
 // NOLINTNEXTLINE
-TEST(HashTableTest, DISABLED_SampleTest) {
+TEST(HashTableTest, SampleTest) {
   auto *disk_manager = new DiskManager("test.db");
   auto *bpm = new BufferPoolManagerInstance(50, disk_manager);
   DiskExtendibleHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), HashFunction<int>());
@@ -117,4 +118,116 @@ TEST(HashTableTest, DISABLED_SampleTest) {
   delete bpm;
 }
 
+TEST(HashTableTest, GrowShrinkTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  DiskExtendibleHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), HashFunction<int>());
+
+  // enough pairs to split the first bucket several times
+  const int num_keys = 5000;
+  for (int i = 0; i < num_keys; i++) {
+    EXPECT_TRUE(ht.Insert(nullptr, i, i));
+  }
+  EXPECT_FALSE(ht.Insert(nullptr, 42, 42));
+  ht.VerifyIntegrity();
+  EXPECT_GT(ht.GetGlobalDepth(), 0);
+  for (int i = 0; i < num_keys; i++) {
+    std::vector<int> res;
+    ht.GetValue(nullptr, i, &res);
+    ASSERT_EQ(1, res.size()) << "Failed to keep " << i << std::endl;
+    EXPECT_EQ(i, res[0]);
+  }
+
+  // emptied buckets are merged back and the directory shrinks
+  for (int i = 0; i < num_keys; i++) {
+    EXPECT_TRUE(ht.Remove(nullptr, i, i));
+  }
+  EXPECT_FALSE(ht.Remove(nullptr, 42, 42));
+  ht.VerifyIntegrity();
+  EXPECT_EQ(ht.GetGlobalDepth(), 0);
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+TEST(HashTableTest, DuplicateKeyTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  DiskExtendibleHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), HashFunction<int>());
+
+  // one key with more values than a bucket page holds goes to overflow pages instead of splitting
+  const int num_values = 2000;
+  for (int i = 0; i < num_values; i++) {
+    EXPECT_TRUE(ht.Insert(nullptr, 7, i));
+  }
+  EXPECT_FALSE(ht.Insert(nullptr, 7, 1500));
+  EXPECT_TRUE(ht.Insert(nullptr, 8, 8));
+  ht.VerifyIntegrity();
+  std::vector<int> res;
+  ht.GetValue(nullptr, 7, &res);
+  ASSERT_EQ(static_cast<size_t>(num_values), res.size());
+  std::sort(res.begin(), res.end());
+  for (int i = 0; i < num_values; i++) {
+    EXPECT_EQ(i, res[i]);
+  }
+
+  for (int i = 0; i < num_values; i++) {
+    EXPECT_TRUE(ht.Remove(nullptr, 7, i));
+  }
+  EXPECT_FALSE(ht.Remove(nullptr, 7, 0));
+  EXPECT_TRUE(ht.Remove(nullptr, 8, 8));
+  res.clear();
+  EXPECT_FALSE(ht.GetValue(nullptr, 7, &res));
+  ht.VerifyIntegrity();
+  EXPECT_EQ(ht.GetGlobalDepth(), 0);
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+TEST(HashTableTest, ConcurrentTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  DiskExtendibleHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), HashFunction<int>());
+
+  // every thread inserts its own keys, checks them and removes every other one, splits and merges interleave
+  const int num_threads = 4;
+  const int keys_per_thread = 1000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back([&ht, t]() {
+      for (int i = t * keys_per_thread; i < (t + 1) * keys_per_thread; i++) {
+        EXPECT_TRUE(ht.Insert(nullptr, i, i));
+      }
+      for (int i = t * keys_per_thread; i < (t + 1) * keys_per_thread; i++) {
+        std::vector<int> res;
+        ht.GetValue(nullptr, i, &res);
+        EXPECT_EQ(1, res.size());
+        if (i % 2 == 1) {
+          EXPECT_TRUE(ht.Remove(nullptr, i, i));
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  ht.VerifyIntegrity();
+  for (int i = 0; i < num_threads * keys_per_thread; i++) {
+    std::vector<int> res;
+    ht.GetValue(nullptr, i, &res);
+    EXPECT_EQ(i % 2 == 0 ? 1 : 0, res.size());
+  }
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
 }  // namespace bustub
@@ -0,0 +1,204 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// linear_probe_hash_table_test.cpp
+//
+// Identification: test/container/disk/hash/linear_probe_hash_table_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "container/disk/hash/linear_probe_hash_table.h"
+#include "gtest/gtest.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(LinearProbeHashTableTest, SampleTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  LinearProbeHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), 1000, HashFunction<int>());
+  size_t initial_size = ht.GetSize();
+  EXPECT_GE(initial_size, 1000);
+
+  for (int i = 0; i < 5; i++) {
+    EXPECT_TRUE(ht.Insert(nullptr, i, i));
+    std::vector<int> res;
+    EXPECT_TRUE(ht.GetValue(nullptr, i, &res));
+    ASSERT_EQ(1, res.size());
+    EXPECT_EQ(i, res[0]);
+  }
+
+  // a key may have several values, but a pair is only stored once
+  for (int i = 0; i < 5; i++) {
+    EXPECT_EQ(i != 0, ht.Insert(nullptr, i, 2 * i));
+    EXPECT_FALSE(ht.Insert(nullptr, i, 2 * i));
+    std::vector<int> res;
+    ht.GetValue(nullptr, i, &res);
+    std::sort(res.begin(), res.end());
+    if (i == 0) {
+      EXPECT_EQ(std::vector<int>{0}, res);
+    } else {
+      EXPECT_EQ((std::vector<int>{i, 2 * i}), res);
+    }
+  }
+
+  std::vector<int> res;
+  EXPECT_FALSE(ht.GetValue(nullptr, 20, &res));
+  EXPECT_TRUE(res.empty());
+
+  for (int i = 0; i < 5; i++) {
+    EXPECT_TRUE(ht.Remove(nullptr, i, i));
+    EXPECT_FALSE(ht.Remove(nullptr, i, i));
+    res.clear();
+    ht.GetValue(nullptr, i, &res);
+    if (i == 0) {
+      EXPECT_TRUE(res.empty());
+    } else {
+      EXPECT_EQ(std::vector<int>{2 * i}, res);
+    }
+  }
+  EXPECT_EQ(initial_size, ht.GetSize());
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+// NOLINTNEXTLINE
+TEST(LinearProbeHashTableTest, GrowTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  LinearProbeHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), 0, HashFunction<int>());
+  size_t initial_size = ht.GetSize();
+
+  // the table doubles whenever it would be more than 7/8 full
+  const int num_keys = 20000;
+  for (int i = 0; i < num_keys; i++) {
+    EXPECT_TRUE(ht.Insert(nullptr, i, i));
+  }
+  EXPECT_GT(ht.GetSize(), initial_size);
+  EXPECT_GE(ht.GetSize() * 7, num_keys * 8);
+  for (int i = 0; i < num_keys; i++) {
+    std::vector<int> res;
+    ht.GetValue(nullptr, i, &res);
+    ASSERT_EQ(1, res.size()) << "lost key " << i;
+    EXPECT_EQ(i, res[0]);
+  }
+
+  for (int i = 0; i < num_keys; i += 2) {
+    EXPECT_TRUE(ht.Remove(nullptr, i, i));
+  }
+  for (int i = 0; i < num_keys; i++) {
+    std::vector<int> res;
+    EXPECT_EQ(i % 2 == 1, ht.GetValue(nullptr, i, &res)) << "key " << i;
+  }
+
+  // churn leaves tombstones behind, which are dropped by rebuilding at the same size instead of growing
+  size_t size = ht.GetSize();
+  for (int round = 0; round < 10; round++) {
+    for (int i = 0; i < num_keys; i += 2) {
+      EXPECT_TRUE(ht.Insert(nullptr, num_keys * (round + 1) + i, i));
+    }
+    for (int i = 0; i < num_keys; i += 2) {
+      EXPECT_TRUE(ht.Remove(nullptr, num_keys * (round + 1) + i, i));
+    }
+  }
+  EXPECT_EQ(size, ht.GetSize());
+  for (int i = 1; i < num_keys; i += 2) {
+    std::vector<int> res;
+    ht.GetValue(nullptr, i, &res);
+    EXPECT_EQ(std::vector<int>{i}, res);
+  }
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+// NOLINTNEXTLINE
+TEST(LinearProbeHashTableTest, DuplicateKeyTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  LinearProbeHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), 0, HashFunction<int>());
+
+  // the values of one key fill consecutive groups, across block pages
+  const int num_values = 2000;
+  for (int i = 0; i < num_values; i++) {
+    EXPECT_TRUE(ht.Insert(nullptr, 7, i));
+  }
+  EXPECT_FALSE(ht.Insert(nullptr, 7, 1500));
+  EXPECT_TRUE(ht.Insert(nullptr, 8, 8));
+  std::vector<int> res;
+  ht.GetValue(nullptr, 7, &res);
+  ASSERT_EQ(static_cast<size_t>(num_values), res.size());
+  std::sort(res.begin(), res.end());
+  for (int i = 0; i < num_values; i++) {
+    EXPECT_EQ(i, res[i]);
+  }
+
+  for (int i = 0; i < num_values; i++) {
+    EXPECT_TRUE(ht.Remove(nullptr, 7, i));
+  }
+  EXPECT_FALSE(ht.Remove(nullptr, 7, 0));
+  res.clear();
+  EXPECT_FALSE(ht.GetValue(nullptr, 7, &res));
+  res.clear();
+  ht.GetValue(nullptr, 8, &res);
+  EXPECT_EQ(std::vector<int>{8}, res);
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+// NOLINTNEXTLINE
+TEST(LinearProbeHashTableTest, ConcurrentTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  LinearProbeHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), 0, HashFunction<int>());
+
+  // every thread inserts its own keys, checks them and removes every other one while the table grows
+  const int num_threads = 4;
+  const int keys_per_thread = 1000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back([&ht, t]() {
+      for (int i = t * keys_per_thread; i < (t + 1) * keys_per_thread; i++) {
+        EXPECT_TRUE(ht.Insert(nullptr, i, i));
+      }
+      for (int i = t * keys_per_thread; i < (t + 1) * keys_per_thread; i++) {
+        std::vector<int> res;
+        ht.GetValue(nullptr, i, &res);
+        EXPECT_EQ(1, res.size());
+        if (i % 2 == 1) {
+          EXPECT_TRUE(ht.Remove(nullptr, i, i));
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  for (int i = 0; i < num_threads * keys_per_thread; i++) {
+    std::vector<int> res;
+    ht.GetValue(nullptr, i, &res);
+    EXPECT_EQ(i % 2 == 0 ? 1 : 0, res.size());
+  }
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+}  // namespace bustub
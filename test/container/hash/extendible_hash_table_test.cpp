@@ -68,4 +68,52 @@ TEST(ExtendibleHashTableTest, ConcurrentInsertTest) {
   }
 }
 
+TEST(ExtendibleHashTableTest, ConcurrentMixedTest) {
+  const int num_threads = 4;
+  const int keys_per_thread = 2000;
+  auto table = std::make_unique<ExtendibleHashTable<int, int>>(4);
+
+  // every thread inserts its own keys, updates them, removes every other one and reads the keys of the others
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads);
+  for (int tid = 0; tid < num_threads; tid++) {
+    threads.emplace_back([tid, &table]() {
+      for (int i = 0; i < keys_per_thread; i++) {
+        int key = i * num_threads + tid;
+        table->Insert(key, key);
+        table->Insert(key, -key);
+        int val;
+        EXPECT_TRUE(table->Find(key, val));
+        EXPECT_EQ(-key, val);
+        // the key of another thread is either missing or carries one of its two values
+        int other = i * num_threads + (tid + 1) % num_threads;
+        if (table->Find(other, val)) {
+          EXPECT_TRUE(val == other || val == -other);
+        }
+        if (i % 2 == 1) {
+          EXPECT_TRUE(table->Remove(key));
+          EXPECT_FALSE(table->Find(key, val));
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  for (int key = 0; key < num_threads * keys_per_thread; key++) {
+    int val;
+    if ((key / num_threads) % 2 == 1) {
+      EXPECT_FALSE(table->Find(key, val));
+    } else {
+      EXPECT_TRUE(table->Find(key, val));
+      EXPECT_EQ(-key, val);
+    }
+  }
+  // every directory slot points to a bucket no deeper than the directory
+  for (int i = 0; i < (1 << table->GetGlobalDepth()); i++) {
+    EXPECT_LE(table->GetLocalDepth(i), table->GetGlobalDepth());
+  }
+}
+
 }  // namespace bustub
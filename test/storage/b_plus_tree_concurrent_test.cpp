@@ -10,6 +10,8 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>  // NOLINT
 #include <cstdio>
 #include <functional>
@@ -21,6 +23,33 @@
 #include "test_util.h"  // NOLINT
 
 namespace bustub {
+// a buffer pool that counts the pages fetched from it
+class CountingBufferPoolManager : public BufferPoolManagerInstance {
+ public:
+  using BufferPoolManagerInstance::BufferPoolManagerInstance;
+  std::atomic<size_t> fetches_{0};
+
+ protected:
+  auto FetchPgImp(page_id_t page_id) -> Page * override {
+    fetches_++;
+    return BufferPoolManagerInstance::FetchPgImp(page_id);
+  }
+};
+
+// helper function to count the frames of the pool that are still pinned, by allocating pages until it runs out
+auto CountPinnedFrames(BufferPoolManager *bpm) -> size_t {
+  std::vector<page_id_t> page_ids;
+  page_id_t page_id;
+  while (bpm->NewPage(&page_id) != nullptr) {
+    page_ids.push_back(page_id);
+  }
+  for (auto id : page_ids) {
+    bpm->UnpinPage(id, false);
+    bpm->DeletePage(id);
+  }
+  return bpm->GetPoolSize() - page_ids.size();
+}
+
 // helper function to launch multiple threads
 template <typename... Args>
 void LaunchParallelTest(uint64_t num_threads, Args &&...args) {
@@ -333,4 +362,220 @@ TEST(BPlusTreeConcurrentTest, MixTest) {
   remove("test.log");
 }
 
+TEST(BPlusTreeConcurrentTest, BLinkTest) {
+  // create KeyComparator and index schema
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+
+  auto *disk_manager = new DiskManager("test.db");
+  BufferPoolManager *bpm = new BufferPoolManagerInstance(200, disk_manager);
+  // create b+ tree in B-link mode with small nodes, so that splits happen all the time
+  BPlusTree<GenericKey<8>, RID, GenericComparator<8>> tree("foo_pk", bpm, comparator, 4, 5, true);
+
+  // create and fetch header_page
+  page_id_t page_id;
+  auto header_page = bpm->NewPage(&page_id);
+  (void)header_page;
+  // first, populate index with the even keys
+  std::vector<int64_t> keys;
+  for (int64_t key = 2; key <= 2000; key += 2) {
+    keys.push_back(key);
+  }
+  InsertHelper(&tree, keys);
+
+  // insert the odd keys while other threads keep looking up the even ones
+  std::vector<int64_t> odd_keys;
+  for (int64_t key = 1; key < 2000; key += 2) {
+    odd_keys.push_back(key);
+  }
+  std::atomic<int> misses{0};
+  std::thread reader([&] {
+    GenericKey<8> index_key;
+    std::vector<RID> rids;
+    for (int round = 0; round < 3; round++) {
+      for (auto key : keys) {
+        rids.clear();
+        index_key.SetFromInteger(key);
+        if (!tree.GetValue(index_key, &rids) || rids[0].GetSlotNum() != key) {
+          misses++;
+        }
+      }
+    }
+  });
+  LaunchParallelTest(2, InsertHelperSplit, &tree, odd_keys, 2);
+  reader.join();
+  EXPECT_EQ(misses, 0);
+
+  // delete a whole range, leaving empty leaves behind, and every other odd key
+  std::vector<int64_t> remove_keys;
+  for (int64_t key = 1; key <= 1000; key++) {
+    remove_keys.push_back(key);
+  }
+  for (int64_t key = 1001; key < 2000; key += 4) {
+    remove_keys.push_back(key);
+  }
+  LaunchParallelTest(2, DeleteHelperSplit, &tree, remove_keys, 2);
+
+  // a reverse scan walks the prev links across the empty leaves
+  std::vector<int64_t> expected;
+  for (int64_t key = 1001; key <= 2000; key++) {
+    if (key % 4 != 1) {
+      expected.push_back(key);
+    }
+  }
+  std::vector<int64_t> scanned;
+  for (auto iterator = tree.RBegin(); !iterator.IsEnd(); ++iterator) {
+    scanned.push_back((*iterator).second.GetSlotNum());
+  }
+  std::reverse(scanned.begin(), scanned.end());
+  EXPECT_EQ(scanned, expected);
+
+  scanned.clear();
+  for (auto iterator = tree.Begin(); !iterator.IsEnd(); ++iterator) {
+    scanned.push_back((*iterator).second.GetSlotNum());
+  }
+  EXPECT_EQ(scanned, expected);
+
+  // writers splitting leaves and internal nodes at the same time post every separator
+  std::vector<int64_t> more_keys;
+  for (int64_t key = 2001; key <= 6000; key++) {
+    more_keys.push_back(key);
+    expected.push_back(key);
+  }
+  LaunchParallelTest(4, InsertHelperSplit, &tree, more_keys, 4);
+  scanned.clear();
+  for (auto iterator = tree.Begin(); !iterator.IsEnd(); ++iterator) {
+    scanned.push_back((*iterator).second.GetSlotNum());
+  }
+  EXPECT_EQ(scanned, expected);
+  GenericKey<8> index_key;
+  std::vector<RID> rids;
+  for (auto key : more_keys) {
+    rids.clear();
+    index_key.SetFromInteger(key);
+    ASSERT_TRUE(tree.GetValue(index_key, &rids)) << key;
+  }
+  EXPECT_EQ(tree.GetEntryCount(), expected.size());
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete disk_manager;
+  delete bpm;
+  remove("test.db");
+  remove("test.log");
+}
+
+TEST(BPlusTreeConcurrentTest, BLinkPinnedLevelsTest) {
+  // create KeyComparator and index schema
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new CountingBufferPoolManager(100, disk_manager);
+
+  // create and fetch header_page
+  page_id_t page_id;
+  auto header_page = bpm->NewPage(&page_id);
+  (void)header_page;
+  {
+    // create b+ tree in B-link mode keeping the top two levels pinned, the root splits several times
+    BPlusTree<GenericKey<8>, RID, GenericComparator<8>> tree("foo_pk", bpm, comparator, 4, 5, true, 2);
+    std::vector<int64_t> keys;
+    for (int64_t key = 1; key <= 2000; key++) {
+      keys.push_back(key);
+    }
+    // lookups run over the swizzled levels while the insertions keep splitting them
+    std::atomic<int> found{0};
+    std::thread reader([&] {
+      GenericKey<8> index_key;
+      std::vector<RID> rids;
+      for (auto key : keys) {
+        rids.clear();
+        index_key.SetFromInteger(key);
+        if (tree.GetValue(index_key, &rids)) {
+          EXPECT_EQ(rids[0].GetSlotNum(), key);
+          found++;
+        }
+      }
+    });
+    LaunchParallelTest(2, InsertHelperSplit, &tree, keys, 2);
+    reader.join();
+
+    GenericKey<8> index_key;
+    std::vector<RID> rids;
+    for (auto key : keys) {
+      rids.clear();
+      index_key.SetFromInteger(key);
+      EXPECT_TRUE(tree.GetValue(index_key, &rids));
+      EXPECT_EQ(rids[0].GetSlotNum(), key);
+    }
+
+    int64_t current_key = 2000;
+    for (auto iterator = tree.RBegin(); !iterator.IsEnd(); ++iterator) {
+      EXPECT_EQ((*iterator).second.GetSlotNum(), current_key);
+      current_key--;
+    }
+    EXPECT_EQ(current_key, 0);
+
+    // once swizzled, a lookup only fetches the levels below the top two from the buffer pool
+    ASSERT_GT(tree.GetHeight(), 3);
+    for (auto key : {1, 777, 2000}) {
+      rids.clear();
+      index_key.SetFromInteger(key);
+      size_t fetches = bpm->fetches_;
+      EXPECT_TRUE(tree.GetValue(index_key, &rids));
+      EXPECT_EQ(bpm->fetches_ - fetches, tree.GetHeight() - 2);
+    }
+
+    // the nodes pushed below the top two levels by root splits were unpinned: only the root and its
+    // children stay pinned, next to the header page
+    auto *root_page = bpm->FetchPage(tree.GetRootPageId());
+    auto root_size = reinterpret_cast<BPlusTreePage *>(root_page->GetData())->GetSize();
+    bpm->UnpinPage(tree.GetRootPageId(), false);
+    EXPECT_LE(CountPinnedFrames(bpm), 1 + 1 + root_size);
+  }
+  // the destructor of the tree unpins the rest
+  EXPECT_EQ(CountPinnedFrames(bpm), 1);
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete disk_manager;
+  delete bpm;
+  remove("test.db");
+  remove("test.log");
+}
+
+TEST(BPlusTreeConcurrentTest, BLinkPinnedPoolShareTest) {
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new CountingBufferPoolManager(40, disk_manager);
+  page_id_t page_id;
+  auto header_page = bpm->NewPage(&page_id);
+  (void)header_page;
+  {
+    // asking for every level to be pinned still pins at most an eighth of the pool
+    BPlusTree<GenericKey<8>, RID, GenericComparator<8>> tree("foo_pk", bpm, comparator, 4, 5, true, 100);
+    std::vector<int64_t> keys;
+    for (int64_t key = 1; key <= 1000; key++) {
+      keys.push_back(key);
+    }
+    InsertHelper(&tree, keys);
+    GenericKey<8> index_key;
+    std::vector<RID> rids;
+    for (auto key : keys) {
+      rids.clear();
+      index_key.SetFromInteger(key);
+      EXPECT_TRUE(tree.GetValue(index_key, &rids));
+    }
+    EXPECT_LE(CountPinnedFrames(bpm), 1 + 40 / BLINK_PINNED_POOL_DIVISOR);
+  }
+  EXPECT_EQ(CountPinnedFrames(bpm), 1);
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete disk_manager;
+  delete bpm;
+  remove("test.db");
+  remove("test.log");
+}
+
 }  // namespace bustub
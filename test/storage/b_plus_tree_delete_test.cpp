@@ -163,4 +163,154 @@ TEST(BPlusTreeTests, DeleteTest2) {
   remove("test.db");
   remove("test.log");
 }
+
+TEST(BPlusTreeTests, StatsTest) {
+  // create KeyComparator and index schema
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+
+  auto *disk_manager = new DiskManager("test.db");
+  BufferPoolManager *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  // create b+ tree
+  BPlusTree<GenericKey<8>, RID, GenericComparator<8>> tree("foo_pk", bpm, comparator, 4, 5);
+  GenericKey<8> index_key;
+  RID rid;
+  // create transaction
+  auto *transaction = new Transaction(0);
+
+  // create and fetch header_page
+  page_id_t page_id;
+  auto header_page = bpm->NewPage(&page_id);
+  (void)header_page;
+
+  // walk the leftmost path down and the leaf chain across, the counters of the tree must agree
+  auto check_shape = [&](size_t entries) {
+    EXPECT_EQ(tree.GetEntryCount(), entries);
+    int height = 0;
+    size_t leaves = 0;
+    page_id_t curr = tree.GetRootPageId();
+    while (curr != INVALID_PAGE_ID) {
+      auto *page = bpm->FetchPage(curr);
+      auto *node = reinterpret_cast<BPlusTreePage *>(page->GetData());
+      height++;
+      if (node->IsLeafPage()) {
+        bpm->UnpinPage(curr, false);
+        break;
+      }
+      auto next = reinterpret_cast<BPlusTreeInternalPage<GenericKey<8>, page_id_t, GenericComparator<8>> *>(node)
+                      ->ValueAt(0);
+      bpm->UnpinPage(curr, false);
+      curr = next;
+    }
+    while (curr != INVALID_PAGE_ID) {
+      auto *page = bpm->FetchPage(curr);
+      auto next = reinterpret_cast<BPlusTreeLeafPage<GenericKey<8>, RID, GenericComparator<8>> *>(page->GetData())
+                      ->GetNextPageId();
+      bpm->UnpinPage(curr, false);
+      leaves++;
+      curr = next;
+    }
+    EXPECT_EQ(tree.GetHeight(), height);
+    EXPECT_EQ(tree.GetLeafCount(), leaves);
+  };
+
+  check_shape(0);
+  std::vector<int64_t> keys;
+  for (int64_t key = 1; key <= 100; key++) {
+    keys.push_back(key);
+    rid.Set(0, key);
+    index_key.SetFromInteger(key);
+    tree.Insert(index_key, rid, transaction);
+  }
+  // a duplicate changes nothing
+  tree.Insert(index_key, rid, transaction);
+  check_shape(100);
+  EXPECT_EQ(tree.GetModificationCount(), 100);
+
+  std::reverse(keys.begin(), keys.end());
+  for (size_t i = 0; i < keys.size(); i++) {
+    index_key.SetFromInteger(keys[i]);
+    tree.Remove(index_key, transaction);
+    if (i % 10 == 9) {
+      check_shape(keys.size() - i - 1);
+    }
+  }
+  EXPECT_EQ(tree.GetModificationCount(), 200);
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete transaction;
+  delete disk_manager;
+  delete bpm;
+  remove("test.db");
+  remove("test.log");
+}
+
+TEST(BPlusTreeTests, ReverseScanEmptyLeafTest) {
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+
+  auto *disk_manager = new DiskManager("test.db");
+  BufferPoolManager *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  BPlusTree<GenericKey<8>, RID, GenericComparator<8>> tree("foo_pk", bpm, comparator, 3, 3);
+  GenericKey<8> index_key;
+  RID rid;
+  auto *transaction = new Transaction(0);
+
+  page_id_t page_id;
+  auto header_page = bpm->NewPage(&page_id);
+  (void)header_page;
+
+  for (int64_t key = 1; key <= 30; key++) {
+    rid.Set(0, key);
+    index_key.SetFromInteger(key);
+    tree.Insert(index_key, rid, transaction);
+  }
+
+  // walk down to the leftmost leaf, then empty two adjacent leaves in the middle of the chain in place
+  using InternalPage = BPlusTreeInternalPage<GenericKey<8>, page_id_t, GenericComparator<8>>;
+  using LeafPage = BPlusTreeLeafPage<GenericKey<8>, RID, GenericComparator<8>>;
+  page_id_t curr = tree.GetRootPageId();
+  while (true) {
+    auto *node = reinterpret_cast<BPlusTreePage *>(bpm->FetchPage(curr)->GetData());
+    if (node->IsLeafPage()) {
+      bpm->UnpinPage(curr, false);
+      break;
+    }
+    auto next = reinterpret_cast<InternalPage *>(node)->ValueAt(0);
+    bpm->UnpinPage(curr, false);
+    curr = next;
+  }
+  for (int i = 0; i < 7; i++) {
+    auto *leaf = reinterpret_cast<LeafPage *>(bpm->FetchPage(curr)->GetData());
+    page_id_t next = leaf->GetNextPageId();
+    if (i >= 5) {
+      leaf->SetSize(0);
+    }
+    bpm->UnpinPage(curr, i >= 5);
+    curr = next;
+  }
+
+  std::vector<int64_t> forward;
+  for (auto iterator = tree.Begin(); !iterator.IsEnd(); ++iterator) {
+    forward.push_back((*iterator).second.GetSlotNum());
+  }
+  EXPECT_LT(forward.size(), 30);
+  EXPECT_EQ(forward.front(), 1);
+  EXPECT_EQ(forward.back(), 30);
+
+  // the reverse scan steps over the empty leaves instead of stopping at them
+  std::vector<int64_t> backward;
+  for (auto iterator = tree.RBegin(); !iterator.IsEnd(); ++iterator) {
+    backward.push_back((*iterator).second.GetSlotNum());
+  }
+  std::reverse(backward.begin(), backward.end());
+  EXPECT_EQ(forward, backward);
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete transaction;
+  delete disk_manager;
+  delete bpm;
+  remove("test.db");
+  remove("test.log");
+}
 }  // namespace bustub
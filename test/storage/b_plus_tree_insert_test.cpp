@@ -12,6 +12,7 @@
 
 #include <algorithm>
 #include <cstdio>
+#include <random>
 
 #include "buffer/buffer_pool_manager_instance.h"
 #include "gtest/gtest.h"
@@ -195,4 +196,92 @@ TEST(BPlusTreeTests, InsertTest3) {
   remove("test.db");
   remove("test.log");
 }
+TEST(BPlusTreeTests, BatchTest) {
+  // create KeyComparator and index schema
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+
+  auto *disk_manager = new DiskManager("test.db");
+  BufferPoolManager *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  // create b+ tree
+  BPlusTree<GenericKey<8>, RID, GenericComparator<8>> tree("foo_pk", bpm, comparator, 4, 5);
+  // create transaction
+  auto *transaction = new Transaction(0);
+
+  // create and fetch header_page
+  page_id_t page_id;
+  auto header_page = bpm->NewPage(&page_id);
+  (void)header_page;
+
+  // a shuffled batch with a duplicate key, then a second batch interleaved with the first
+  std::vector<int64_t> keys;
+  for (int64_t key = 2; key <= 200; key += 2) {
+    keys.push_back(key);
+  }
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+  keys.push_back(keys[0]);
+  for (auto batch_start : {static_cast<int64_t>(0), static_cast<int64_t>(1)}) {
+    std::vector<std::pair<GenericKey<8>, RID>> entries;
+    for (auto key : keys) {
+      entries.emplace_back(GenericKey<8>(), RID(static_cast<int32_t>(key - batch_start), key - batch_start));
+      entries.back().first.SetFromInteger(key - batch_start);
+    }
+    EXPECT_EQ(tree.InsertBatch(&entries, transaction), 100);
+  }
+
+  int64_t current_key = 1;
+  for (auto iterator = tree.Begin(); iterator != tree.End(); ++iterator) {
+    EXPECT_EQ((*iterator).second.GetSlotNum(), current_key);
+    current_key++;
+  }
+  EXPECT_EQ(current_key, 201);
+
+  // look up present and missing keys in random order
+  std::vector<GenericKey<8>> lookup_keys;
+  for (int64_t key = 250; key >= 0; key -= 5) {
+    lookup_keys.emplace_back();
+    lookup_keys.back().SetFromInteger(key);
+  }
+  std::vector<std::vector<RID>> results;
+  tree.LookupBatch(lookup_keys, &results, transaction);
+  ASSERT_EQ(results.size(), lookup_keys.size());
+  for (size_t i = 0; i < lookup_keys.size(); i++) {
+    int64_t key = 250 - static_cast<int64_t>(i) * 5;
+    if (key >= 1 && key <= 200) {
+      ASSERT_EQ(results[i].size(), 1);
+      EXPECT_EQ(results[i][0].GetSlotNum(), key);
+    } else {
+      EXPECT_TRUE(results[i].empty());
+    }
+  }
+
+  // the write paths also work without a transaction, and release every page they latched
+  std::vector<std::pair<GenericKey<8>, RID>> entries;
+  for (int64_t key = 201; key <= 300; key++) {
+    entries.emplace_back(GenericKey<8>(), RID(static_cast<int32_t>(key), key));
+    entries.back().first.SetFromInteger(key);
+  }
+  EXPECT_EQ(tree.InsertBatch(&entries), 100);
+  GenericKey<8> index_key;
+  index_key.SetFromInteger(301);
+  EXPECT_TRUE(tree.Insert(index_key, RID(301, 301)));
+  for (int64_t key = 1; key <= 150; key++) {
+    index_key.SetFromInteger(key);
+    tree.Remove(index_key);
+  }
+  current_key = 151;
+  for (auto iterator = tree.Begin(); iterator != tree.End(); ++iterator) {
+    EXPECT_EQ((*iterator).second.GetSlotNum(), current_key);
+    current_key++;
+  }
+  EXPECT_EQ(current_key, 302);
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete transaction;
+  delete disk_manager;
+  delete bpm;
+  remove("test.db");
+  remove("test.log");
+}
+
 }  // namespace bustub
@@ -0,0 +1,102 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// index_stats_selectivity_test.cpp
+//
+// Identification: test/storage/index_stats_selectivity_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "storage/index/index_stats.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+namespace {
+
+auto Int(int32_t value) -> Value { return ValueFactory::GetIntegerValue(value); }
+
+/** Histogram with the given bounds on an integer column */
+auto MakeStats(const std::vector<int32_t> &bounds, std::size_t distinct_keys) -> IndexStats {
+  IndexStats stats;
+  stats.distinct_keys_ = distinct_keys;
+  for (auto bound : bounds) {
+    stats.histogram_bounds_.push_back(Int(bound));
+  }
+  return stats;
+}
+
+}  // namespace
+
+TEST(IndexStatsTest, FractionBelowTest) {
+  // four buckets of a quarter of the entries each: [0, 10], [10, 20], [20, 30], [30, 40]
+  auto stats = MakeStats({0, 10, 20, 30, 40}, 50);
+
+  EXPECT_DOUBLE_EQ(0, stats.FractionBelow(Int(-5)));
+  EXPECT_DOUBLE_EQ(0, stats.FractionBelow(Int(0)));
+  EXPECT_DOUBLE_EQ(0.125, stats.FractionBelow(Int(5)));
+  EXPECT_DOUBLE_EQ(0.25, stats.FractionBelow(Int(10)));
+  EXPECT_DOUBLE_EQ(0.3, stats.FractionBelow(Int(12)));
+  EXPECT_DOUBLE_EQ(0.625, stats.FractionBelow(Int(25)));
+  EXPECT_DOUBLE_EQ(1, stats.FractionBelow(Int(40)));
+  EXPECT_DOUBLE_EQ(1, stats.FractionBelow(Int(45)));
+}
+
+TEST(IndexStatsTest, DuplicateBoundsTest) {
+  // the value 5 fills the middle two buckets
+  auto stats = MakeStats({0, 5, 5, 5, 10}, 11);
+
+  EXPECT_DOUBLE_EQ(0.25, stats.FractionBelow(Int(5)));
+  EXPECT_DOUBLE_EQ(0.8, stats.FractionBelow(Int(6)));
+  // a range around the frequent value gets both of its buckets
+  EXPECT_DOUBLE_EQ(0.55, stats.EstimateSelectivity(Int(5), Int(6)));
+  EXPECT_DOUBLE_EQ(0.25, stats.EstimateSelectivity(std::nullopt, Int(5)));
+
+  // a histogram of a single value
+  auto single = MakeStats({7, 7}, 1);
+  EXPECT_DOUBLE_EQ(0, single.FractionBelow(Int(7)));
+  EXPECT_DOUBLE_EQ(1, single.FractionBelow(Int(8)));
+  EXPECT_DOUBLE_EQ(1, single.EstimateSelectivity(Int(7), Int(7)));
+}
+
+TEST(IndexStatsTest, EstimateSelectivityTest) {
+  auto stats = MakeStats({0, 10, 20, 30, 40}, 50);
+
+  EXPECT_DOUBLE_EQ(0.5, stats.EstimateSelectivity(Int(10), Int(30)));
+  EXPECT_DOUBLE_EQ(0.625, stats.EstimateSelectivity(std::nullopt, Int(25)));
+  EXPECT_DOUBLE_EQ(0.375, stats.EstimateSelectivity(Int(25), std::nullopt));
+  EXPECT_DOUBLE_EQ(1, stats.EstimateSelectivity(std::nullopt, std::nullopt));
+  EXPECT_DOUBLE_EQ(1, stats.EstimateSelectivity(Int(-10), Int(100)));
+
+  // an equality is one distinct value
+  EXPECT_DOUBLE_EQ(0.02, stats.EstimateSelectivity(Int(20), Int(20)));
+  EXPECT_DOUBLE_EQ(0.02, stats.EstimateSelectivity(Int(21), Int(21)));
+  // an empty or tiny range still holds one distinct value
+  EXPECT_DOUBLE_EQ(0.02, stats.EstimateSelectivity(Int(30), Int(10)));
+  EXPECT_DOUBLE_EQ(0.02, stats.EstimateSelectivity(Int(50), Int(60)));
+
+  // nothing is known without a histogram
+  IndexStats empty;
+  EXPECT_DOUBLE_EQ(1, empty.EstimateSelectivity(Int(10), Int(20)));
+  EXPECT_DOUBLE_EQ(1, empty.EstimateSelectivity(Int(10), Int(10)));
+}
+
+TEST(IndexStatsTest, NonNumericTest) {
+  IndexStats stats;
+  stats.distinct_keys_ = 26;
+  for (const auto *bound : {"a", "m", "z"}) {
+    stats.histogram_bounds_.push_back(ValueFactory::GetVarcharValue(bound));
+  }
+  // strings cannot be interpolated, a value counts for half of its bucket
+  EXPECT_DOUBLE_EQ(0.25, stats.FractionBelow(ValueFactory::GetVarcharValue("c")));
+  EXPECT_DOUBLE_EQ(0.75, stats.FractionBelow(ValueFactory::GetVarcharValue("q")));
+  EXPECT_DOUBLE_EQ(0.5, stats.EstimateSelectivity(ValueFactory::GetVarcharValue("c"),
+                                                  ValueFactory::GetVarcharValue("q")));
+}
+
+}  // namespace bustub
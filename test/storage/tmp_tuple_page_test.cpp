@@ -10,16 +10,19 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <string>
 #include <vector>
 
+#include "buffer/buffer_pool_manager_instance.h"
 #include "gtest/gtest.h"
 #include "storage/page/tmp_tuple_page.h"
+#include "storage/table/tmp_tuple_run.h"
 #include "type/value_factory.h"
 
 namespace bustub {
 
 // NOLINTNEXTLINE
-TEST(TmpTuplePageTest, DISABLED_BasicTest) {
+TEST(TmpTuplePageTest, BasicTest) {
   // There are many ways to do this assignment, and this is only one of them.
   // If you don't like the TmpTuplePage idea, please feel free to delete this test case entirely.
   // You will get full credit as long as you are correctly using a linear probe hash table.
@@ -46,6 +49,66 @@ TEST(TmpTuplePageTest, DISABLED_BasicTest) {
   ASSERT_EQ(*reinterpret_cast<uint32_t *>(data + sizeof(page_id_t) + sizeof(lsn_t)), BUSTUB_PAGE_SIZE - 8);
   ASSERT_EQ(*reinterpret_cast<uint32_t *>(data + BUSTUB_PAGE_SIZE - 8), 4);
   ASSERT_EQ(*reinterpret_cast<uint32_t *>(data + BUSTUB_PAGE_SIZE - 4), 123);
+  ASSERT_EQ(tmp_tuple.GetPageId(), page_id);
+  ASSERT_EQ(tmp_tuple.GetOffset(), BUSTUB_PAGE_SIZE - 8);
+
+  Tuple read;
+  ASSERT_EQ(page.Get(tmp_tuple.GetOffset(), &read), BUSTUB_PAGE_SIZE);
+  ASSERT_EQ(read.GetValue(&schema, 0).GetAs<int32_t>(), 123);
+
+  // Fill the page; the header takes 12 bytes and every tuple 8.
+  size_t inserted = 1;
+  while (page.Insert(tuple, &tmp_tuple)) {
+    inserted++;
+  }
+  ASSERT_EQ(inserted, (BUSTUB_PAGE_SIZE - 12) / 8);
+}
+
+// NOLINTNEXTLINE
+TEST(TmpTuplePageTest, RunTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManagerInstance(5, disk_manager);
+
+  std::vector<Column> columns;
+  columns.emplace_back("A", TypeId::INTEGER);
+  columns.emplace_back("B", TypeId::VARCHAR, 64);
+  Schema schema(columns);
+
+  {
+    // Many more pages than frames, so the run is evicted to disk and read back.
+    TmpTupleRun run(bpm);
+    const int num_tuples = 10000;
+    for (int i = 0; i < num_tuples; i++) {
+      std::vector<Value> values{ValueFactory::GetIntegerValue(i),
+                                ValueFactory::GetVarcharValue(std::string(i % 40, 'x'))};
+      run.Append(Tuple(values, &schema));
+    }
+    run.Finish();
+    ASSERT_EQ(run.Size(), num_tuples);
+
+    for (int pass = 0; pass < 2; pass++) {
+      TmpTupleRun::Reader reader(&run);
+      Tuple tuple;
+      int i = 0;
+      while (reader.Next(&tuple)) {
+        ASSERT_EQ(tuple.GetValue(&schema, 0).GetAs<int32_t>(), i);
+        ASSERT_EQ(tuple.GetValue(&schema, 1).ToString(), std::string(i % 40, 'x'));
+        i++;
+      }
+      ASSERT_EQ(i, num_tuples);
+    }
+
+    TmpTupleRun empty(bpm);
+    empty.Finish();
+    TmpTupleRun::Reader reader(&empty);
+    Tuple tuple;
+    ASSERT_FALSE(reader.Next(&tuple));
+  }
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
 }
 
 }  // namespace bustub
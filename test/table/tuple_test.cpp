@@ -20,6 +20,7 @@
 #include "gtest/gtest.h"
 #include "logging/common.h"
 #include "storage/table/table_heap.h"
+#include "storage/table/table_scan_iterator.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
@@ -71,4 +72,59 @@ TEST(TupleTest, DISABLED_TableHeapTest) {
   delete disk_manager;
 }
 
+// NOLINTNEXTLINE
+TEST(TupleTest, TableScanIteratorTest) {
+  Column col1{"a", TypeId::VARCHAR, 20};
+  Column col2{"b", TypeId::SMALLINT};
+  Column col3{"c", TypeId::BIGINT};
+  std::vector<Column> cols{col1, col2, col3};
+  Schema schema{cols};
+
+  auto *transaction = new Transaction(0);
+  auto *disk_manager = new DiskManager("test.db");
+  auto *buffer_pool_manager = new BufferPoolManagerInstance(10, disk_manager);
+  auto *lock_manager = new LockManager();
+  auto *log_manager = new LogManager(disk_manager);
+  auto *table = new TableHeap(buffer_pool_manager, lock_manager, log_manager, transaction);
+
+  // Tuples of varying sizes over many more pages than frames, with every third one deleted.
+  std::vector<RID> live;
+  std::vector<std::string> payloads;
+  for (int i = 0; i < 3000; ++i) {
+    std::vector<Value> values{ValueFactory::GetVarcharValue(std::string(i % 17, 'a' + i % 26)),
+                              ValueFactory::GetSmallIntValue(static_cast<int16_t>(i)),
+                              ValueFactory::GetBigIntValue(i)};
+    RID rid;
+    ASSERT_TRUE(table->InsertTuple(Tuple(values, &schema), &rid, transaction));
+    if (i % 3 == 0) {
+      ASSERT_TRUE(table->MarkDelete(rid, transaction));
+    } else {
+      live.push_back(rid);
+      payloads.push_back(values[0].ToString());
+    }
+  }
+
+  TableScanIterator scan(table);
+  Tuple tuple;
+  size_t count = 0;
+  while (scan.Next(&tuple)) {
+    ASSERT_LT(count, live.size());
+    ASSERT_EQ(tuple.GetRid(), live[count]);
+    ASSERT_EQ(tuple.GetValue(&schema, 0).ToString(), payloads[count]);
+    count++;
+  }
+  ASSERT_EQ(count, live.size());
+  ASSERT_FALSE(scan.Next(&tuple));
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  remove("test.log");
+  delete table;
+  delete log_manager;
+  delete lock_manager;
+  delete buffer_pool_manager;
+  delete disk_manager;
+  delete transaction;
+}
+
 }  // namespace bustub